@@ -0,0 +1,192 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Kare kümesi: Words x 64 bit. 8x8 için tek kelime, daha büyük tahtalar için kelime dizisi.
+template <std::size_t Words>
+class Bitboard
+{
+public:
+    std::array<std::uint64_t, Words> words{};
+
+    static constexpr std::size_t WORDS = Words;
+    static constexpr int CAPACITY = static_cast<int>(Words * 64);
+
+    void set(int sq) { words[sq >> 6] |= std::uint64_t(1) << (sq & 63); }
+    void reset(int sq) { words[sq >> 6] &= ~(std::uint64_t(1) << (sq & 63)); }
+    bool test(int sq) const { return (words[sq >> 6] >> (sq & 63)) & 1; }
+
+    bool any() const {
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < Words; ++i) acc |= words[i];
+        return acc != 0;
+    }
+
+    bool none() const { return !any(); }
+
+    int count() const {
+        int total = 0;
+        for (std::size_t i = 0; i < Words; ++i) total += std::popcount(words[i]);
+        return total;
+    }
+
+    // En düşük karenin indeksi, boşsa -1
+    int first() const {
+        for (std::size_t i = 0; i < Words; ++i) {
+            if (words[i]) return static_cast<int>(i * 64) + std::countr_zero(words[i]);
+        }
+        return -1;
+    }
+
+    // En düşük kareyi çıkarıp döndür
+    int popFirst() {
+        for (std::size_t i = 0; i < Words; ++i) {
+            if (words[i]) {
+                int bit = std::countr_zero(words[i]);
+                words[i] &= words[i] - 1;
+                return static_cast<int>(i * 64) + bit;
+            }
+        }
+        return -1;
+    }
+
+    bool intersects(const Bitboard &other) const {
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < Words; ++i) acc |= words[i] & other.words[i];
+        return acc != 0;
+    }
+
+    Bitboard &operator|=(const Bitboard &other) {
+        for (std::size_t i = 0; i < Words; ++i) words[i] |= other.words[i];
+        return *this;
+    }
+
+    Bitboard &operator&=(const Bitboard &other) {
+        for (std::size_t i = 0; i < Words; ++i) words[i] &= other.words[i];
+        return *this;
+    }
+
+    Bitboard &operator^=(const Bitboard &other) {
+        for (std::size_t i = 0; i < Words; ++i) words[i] ^= other.words[i];
+        return *this;
+    }
+
+    friend Bitboard operator|(Bitboard a, const Bitboard &b) { return a |= b; }
+    friend Bitboard operator&(Bitboard a, const Bitboard &b) { return a &= b; }
+    friend Bitboard operator^(Bitboard a, const Bitboard &b) { return a ^= b; }
+
+    Bitboard andNot(const Bitboard &other) const {
+        Bitboard result = *this;
+        for (std::size_t i = 0; i < Words; ++i) result.words[i] &= ~other.words[i];
+        return result;
+    }
+
+    bool operator==(const Bitboard &other) const = default;
+};
+
+// Yön indeksleri: 0-3 düz (N, S, E, W), 4-7 çapraz (NE, NW, SE, SW)
+constexpr int DIRECTION_COUNT = 8;
+constexpr int DIRECTION_DX[DIRECTION_COUNT] = {0, 0, 1, -1, 1, -1, 1, -1};
+constexpr int DIRECTION_DY[DIRECTION_COUNT] = {1, -1, 0, 0, 1, 1, -1, -1};
+
+// Ters yön: N<->S, E<->W, NE<->SW, NW<->SE
+constexpr int oppositeDirection(int dir) {
+    return dir < 4 ? dir ^ 1 : 11 - dir;
+}
+
+// (dx, dy) işaretlerinden yön indeksi, aynı hat üzerinde değilse -1
+inline int directionBetween(int dx, int dy) {
+    if (dx == 0 && dy == 0) return -1;
+    if (dx != 0 && dy != 0 && dx != dy && dx != -dy) return -1;
+    int sx = (dx > 0) - (dx < 0);
+    int sy = (dy > 0) - (dy < 0);
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        if (DIRECTION_DX[d] == sx && DIRECTION_DY[d] == sy) return d;
+    }
+    return -1;
+}
+
+// Tahta boyutuna bağlı sabit maskeler; tahtanın kopyaları arasında paylaşılır
+template <std::size_t Words>
+struct BitboardGeometry
+{
+    int board_size;
+
+    // rays[sq * 8 + d]: sq'dan d yönünde tahta kenarına kadar olan kareler (sq hariç)
+    std::vector<Bitboard<Words>> rays;
+
+    explicit BitboardGeometry(int size) : board_size(size), rays(static_cast<std::size_t>(size) * size * DIRECTION_COUNT) {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                int sq = y * size + x;
+                for (int d = 0; d < DIRECTION_COUNT; ++d) {
+                    auto &ray = rays[static_cast<std::size_t>(sq) * DIRECTION_COUNT + d];
+                    for (int cx = x + DIRECTION_DX[d], cy = y + DIRECTION_DY[d];
+                         cx >= 0 && cx < size && cy >= 0 && cy < size;
+                         cx += DIRECTION_DX[d], cy += DIRECTION_DY[d]) {
+                        ray.set(cy * size + cx);
+                    }
+                }
+            }
+        }
+    }
+
+    const Bitboard<Words> &ray(int sq, int dir) const {
+        return rays[static_cast<std::size_t>(sq) * DIRECTION_COUNT + dir];
+    }
+
+    // from ile to arasındaki kareler (uçlar hariç); aynı hatta değillerse boş
+    Bitboard<Words> between(int from, int to) const {
+        int dir = directionBetween(to % board_size - from % board_size, to / board_size - from / board_size);
+        if (dir < 0) return Bitboard<Words>{};
+        Bitboard<Words> mask = ray(from, dir) ^ ray(to, dir);
+        mask.reset(to);
+        return mask;
+    }
+};
+
+// Renk ve taş tipi başına doluluk maskeleri
+template <std::size_t Words>
+class BitboardSet
+{
+public:
+    using Mask = Bitboard<Words>;
+
+    std::shared_ptr<const BitboardGeometry<Words>> geometry;
+    Mask occupied;
+    Mask byColor[2];
+    std::vector<Mask> byType[2];
+
+    BitboardSet() = default;
+    BitboardSet(int size, int typeCount)
+        : geometry(std::make_shared<const BitboardGeometry<Words>>(size)) {
+        byType[0].assign(typeCount, Mask{});
+        byType[1].assign(typeCount, Mask{});
+    }
+
+    void add(int sq, int color, int type) {
+        occupied.set(sq);
+        byColor[color].set(sq);
+        byType[color][type].set(sq);
+    }
+
+    void remove(int sq, int color, int type) {
+        occupied.reset(sq);
+        byColor[color].reset(sq);
+        byType[color][type].reset(sq);
+    }
+
+    bool pathClear(int from, int to, int ignoreSq = -1) const {
+        Mask blockers = geometry->between(from, to) & occupied;
+        if (ignoreSq >= 0) blockers.reset(ignoreSq);
+        return blockers.none();
+    }
+};
+
+#endif
@@ -1,36 +1,104 @@
 #ifndef BOARD_HPP
 #define BOARD_HPP
 
+#include "Bitboard.hpp"
 #include "ConfigReader.hpp"
-#include <unordered_map>
+#include "Move.hpp"
+#include "MovementTable.hpp"
+#include "OccupancyTiles.hpp"
+#include "PieceRegistry.hpp"
+#include "PortalSystem.hpp"
+#include "StandardKernel.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <variant>
 #include <vector>
 #include <memory>
 #include <string>
 
+static_assert(static_cast<long long>(ConfigReader::MAX_BOARD_SIZE) * ConfigReader::MAX_BOARD_SIZE <= Move::MAX_SQUARES,
+              "square indices of the largest board must fit in a move");
+
 class Board
 {
 public:
+    // Kare başına taş kodu: 0 boş, bit 0 renk (1 = siyah), bit 1 taş oynadı mı,
+    // üst bitler tip numarası + 1 (PieceRegistry içinde)
+    using PieceCode = std::uint16_t;
+    static constexpr PieceCode EMPTY = 0;
+    static constexpr PieceCode BLACK_BIT = 1;
+    static constexpr PieceCode MOVED_BIT = 2;
+    static constexpr int TYPE_SHIFT = 2;
+
+    static constexpr int WHITE = 0;
+    static constexpr int BLACK = 1;
+
     int board_size;
 
-    // Pozisyon -> Taş eşlemesi
-    std::unordered_map<std::string, std::shared_ptr<PieceConfig>> board_map;
+    // Kare indeksi (y * board_size + x) -> taş kodu
+    std::vector<PieceCode> squares;
+
+    // Taş tipleri; tahtanın kopyaları arasında paylaşılır
+    std::shared_ptr<const PieceRegistry> registry;
+
+    // Renk başına dolu karelerin listesi
+    std::vector<int> pieceSquares[2];
+
+    // 8x8 karolar halinde doluluk: dolu karoların dolaşılması ve doğrular boyunca boş
+    // karoların atlanması için, her tahta boyutunda tutulur
+    OccupancyTiles occupancy;
+
+    // Bitboard arka ucu: 8x8 tek kelime, 16x16'ya kadar 4, 32x32'ye kadar 16 kelime.
+    // Daha büyük tahtalarda monostate kalır; yol taramaları occupancy karolarıyla yapılır.
+    using Bitboards = std::variant<std::monostate, BitboardSet<1>, BitboardSet<4>, BitboardSet<16>>;
+    Bitboards bitboards;
+
+    // Portallar ve bekleme süreleri
+    PortalSystem portals;
+
+    // Oynanan yarım hamle sayısı (portal bekleme süreleri buna göre hesaplanır)
+    int ply = 0;
+
+    // Hamle sırası; makeMove/unmakeMove ile değişir
+    bool whiteToMove = true;
 
-    // Portal bilgileri
-    std::vector<PortalConfig> portals;
+    // Taş yerleşimi, hamle sırası ve portal bekleme sürelerini kapsayan Zobrist anahtarı
+    std::uint64_t zobristKey = 0;
+
+    // makeMove'un geri alınması için gereken bilgiler
+    struct UndoRecord {
+        Move move;
+        int landing;               // portal sonrası son kare
+        PieceCode mover;           // hamleden önceki kod (oynadı biti dahil)
+        PieceCode captured;        // move.to() üzerindeki alınan taş
+        PieceCode capturedAtExit;  // portal çıkışında alınan taş
+        int portal;                // kullanılan portal, yoksa -1
+        int previousCooldownUntil;
+        std::uint64_t previousKey;
+    };
 
     Board(int size);
 
-    // Tahtayı başlat
+    // Tahtayı başlat; registry verilirse taş tipleri yeniden derlenmez
     void initialize(const std::vector<PieceConfig> &pieces,
-                    const std::vector<PortalConfig> &portals);
+                    const std::vector<PortalConfig> &portals,
+                    std::shared_ptr<const PieceRegistry> compiled = nullptr);
+
+    // Standart ve özel taşlarla birlikte yapılandırmanın tamamından başlat (anlık görüntüden
+    // yüklendiyse derlenmiş tabloları kullanır)
+    void initialize(const GameConfig &config);
 
     // Pozisyon geçerli mi
     bool isPositionValid(const Position &pos) const;
+    bool isSquareValid(int x, int y) const {
+        return x >= 0 && x < board_size && y >= 0 && y < board_size;
+    }
 
     // Tahtayı konsola yazdır
     void print() const;
 
-    // Yeni bir klon tahta döndür
+    // Yeni bir klon tahta döndür (taş tipleri paylaşılır)
     Board clone() const;
 
     // Taş hareket ettir
@@ -39,26 +107,178 @@ public:
     // Kopyalanan tahtada taş hareketi
     bool movePieceForCloneBoard(int x1, int y1, int x2, int y2);
 
-    // Portal kontrolü 
+    // Hamleyi yerinde uygula (alma, portal geçişi, bekleme süresi) ve geri al
+    void makeMove(Move move, UndoRecord &undo);
+    void unmakeMove(const UndoRecord &undo);
+
+    // Konumu doğrudan kur (oyun sonu tabloları için): kareye taş koy ya da EMPTY ile kaldır,
+    // hamle sırasını ve portalın kalan bekleme süresini (yarım hamle) ayarla. Anahtar güncellenir.
+    void setPiece(int sq, PieceCode code);
+    void setSideToMove(bool white);
+    void setPortalCooldown(int portal, int remaining);
+
+    // sq üzerine gelen color rengindeki taşı taşıyacak hazır portal, yoksa -1
+    int findPortalHop(int sq, int color) const;
+    bool isPortalEntry(int sq) const { return portals.isEntry(sq); }
+
+    // Yön koruyan portallardan devam eden hamleler: from'daki taş bir ışın üzerinde boş bir
+    // portal girişine ulaşır ve boş çıkıştan aynı yönde kalan menzili kadar ilerler.
+    // visit(portal, to, flags) true dönerse dolaşma durur; aynı hedefe giden ilk yol geçerlidir.
+    template <typename Visit>
+    bool forEachPortalContinuation(int from, Visit &&visit) const;
+
+    // from'dan to'ya devam eden hamlenin kullandığı portal, yoksa -1
+    int continuationPortal(int from, int to) const;
+
+    // Hamlenin alacağı taş (portal çıkışındaki dahil), yoksa EMPTY
+    PieceCode victimOf(Move move) const;
+
+    std::uint64_t key() const { return zobristKey; }
+
+    // Anahtarı sıfırdan hesapla (artımlı güncellemenin doğrulanması için)
+    std::uint64_t computeKey() const;
+
+    // Portal kontrolü
     void handlePortal(int x1, int y1, int &x2, int &y2);
-    void handleCooldowns();
 
     // Oynanan hamleyi kaydet
     void recordMove(const std::string &input);
 
     std::string getKey(int x, int y) const;
 
+    int squareIndex(int x, int y) const { return y * board_size + x; }
+    int squareX(int sq) const { return sq % board_size; }
+    int squareY(int sq) const { return sq / board_size; }
 
+    PieceCode codeAt(int sq) const { return squares[sq]; }
+    static bool isBlackCode(PieceCode code) { return (code & BLACK_BIT) != 0; }
+    static int colorOf(PieceCode code) { return code & BLACK_BIT; }
+    static bool hasMoved(PieceCode code) { return (code & MOVED_BIT) != 0; }
+    static int typeOf(PieceCode code) { return (code >> TYPE_SHIFT) - 1; }
+    static PieceCode makeCode(int type, int color) { return static_cast<PieceCode>(((type + 1) << TYPE_SHIFT) | color); }
+
+    bool hasPieceAt(int x, int y) const { return squares[squareIndex(x, y)] != EMPTY; }
     bool hasPieceAt(const std::string &key) const;
 
+    // Karedeki taşın tipi, boşsa nullptr
+    const PieceType *pieceAt(int sq) const { return squares[sq] == EMPTY ? nullptr : &pieceType(squares[sq]); }
+    const PieceType *getPiece(const std::string &key) const;
+    const PieceType *getPiece(int x, int y) const { return pieceAt(squareIndex(x, y)); }
+
+    const PieceType &pieceType(PieceCode code) const { return registry->type(typeOf(code)); }
+
+    // İki kare arasındaki (uçlar hariç) tüm kareler boş mu; ignoreSq boş sayılır
+    bool isPathClear(int from, int to, int ignoreSq = -1) const;
+
+    // sq'dan dir yönündeki ilk taşın karesi ve uzaklığı, kenara kadar boşsa -1
+    int firstOccupied(int sq, int dir, int &distance) const {
+        return occupancy.firstOccupied(sq, dir, distance);
+    }
+
+    // Renk başına taş listesi
+    const std::vector<int> &piecesOf(bool isWhite) const { return pieceSquares[isWhite ? WHITE : BLACK]; }
 
-    const std::shared_ptr<PieceConfig> &getPiece(const std::string &key) const;
-    const std::shared_ptr<PieceConfig>& getPiece(int x, int y) const;
+    // Renk başına royal taşların kareleri
+    const std::vector<int> &royalsOf(bool isWhite) const { return royalSquares[isWhite ? WHITE : BLACK]; }
+
+    // sq karesini alabilecek color rengindeki taş sayısı (kendi taşını koruyanlar dahil)
+    int attackersOf(int sq, int color) const {
+        if (standardKernel) return std::popcount(kernelAttackers(sq, color));
+        return attackCount[color][sq];
+    }
+
+    // Standart 8x8 takımda saldırılar bitboard tablolarından anında hesaplanır ve artımlı
+    // saldırı haritası tutulmaz; diğer yapılandırmalar genel yolu kullanır
+    bool usesStandardKernel() const { return standardKernel; }
+    StandardKernel::Kind kernelKind(PieceCode code) const { return pieceType(code).kind; }
+    const BitboardSet<1> &kernelBitboards() const { return *std::get_if<BitboardSet<1>>(&bitboards); }
+
+    std::uint64_t kernelAttackers(int sq, int color) const {
+        return kernelAttackers(sq, color, kernelBitboards().occupied.words[0]);
+    }
+    std::uint64_t kernelAttackers(int sq, int color, std::uint64_t occupied) const {
+        return StandardKernel::attackersTo(kernelBitboards(), registry->standardTypes(), sq, color, occupied);
+    }
+
+    const MovementTable &movementOf(PieceCode code) const { return *pieceType(code).moves[colorOf(code)]; }
+    bool isRoyal(PieceCode code) const { return pieceType(code).has(PieceRegistry::ROYAL); }
 
 
 private:
+    // Kare -> renk listesindeki sırası
+    std::vector<int> listIndex;
+
+    // Her hamlede artımlı güncellenen saldırı sayıları ve royal taş kareleri
+    std::vector<std::uint16_t> attackCount[2];
+    std::vector<int> royalSquares[2];
+
+    bool standardKernel = false;
 
     std::string posToKey(int x, int y) const;
+    bool keyToSquare(const std::string &key, int &sq) const;
+
+    void placeCode(int sq, PieceCode code);
+    void removeCode(int sq);
+    void relocateCode(int from, int to);
+
+    std::uint64_t pieceKey(int sq, PieceCode code) const;
+    std::uint64_t cooldownKey() const;
+
+    void addAttacks(int sq, PieceCode code, int delta);
+    void updateSlidersThrough(int sq, int delta);
+    void moveRoyal(PieceCode code, int from, int to);
+
+    void resetBitboards();
+    void bitboardAdd(int sq, PieceCode code);
+    void bitboardRemove(int sq, PieceCode code);
 };
 
-#endif 
+template <typename Visit>
+bool Board::forEachPortalContinuation(int from, Visit &&visit) const {
+    std::uint8_t directions = portals.continuationDirections(from);
+    if (directions == 0) return false;
+
+    PieceCode mover = squares[from];
+    int color = colorOf(mover);
+    const MovementTable &table = movementOf(mover);
+
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        if (!((directions >> d) & 1)) continue;
+        const auto &ray = table.ray(from, d);
+        int length = ray.length();
+        for (int i = 0; i < length; ++i) {
+            int entry = table.target(ray, i);
+            if (squares[entry] != EMPTY) break;
+            if (!portals.isEntry(entry)) continue;
+
+            int portal = findPortalHop(entry, color);
+            if (portal < 0 || !portals.preservesDirection(portal)) continue;
+            int exit = portals.exitSquare(portal);
+            if (squares[exit] != EMPTY) continue;
+
+            // Girişe kadar i + 1 adım harcandı; çıkıştan sonraki her kare bir adım
+            int moveLeft = ray.moveReach - (i + 1);
+            int captureLeft = ray.captureReach - (i + 1);
+            int x = squareX(exit);
+            int y = squareY(exit);
+            for (int k = 1; k <= std::max(moveLeft, captureLeft); ++k) {
+                int tx = x + k * DIRECTION_DX[d];
+                int ty = y + k * DIRECTION_DY[d];
+                if (!isSquareValid(tx, ty)) break;
+                int to = squareIndex(tx, ty);
+                PieceCode code = squares[to];
+                if (code == EMPTY) {
+                    if (k <= moveLeft && visit(portal, to, Move::PORTAL)) return true;
+                    continue;
+                }
+                if (colorOf(code) != color && k <= captureLeft && visit(portal, to, Move::PORTAL | Move::CAPTURE)) {
+                    return true;
+                }
+                break;
+            }
+        }
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef BOARD_RENDERER_HPP
+#define BOARD_RENDERER_HPP
+
+#include "Board.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Tahtayı önceden ayrılmış tek bir tampona biçimlendirip tek yazımla basar.
+// Artımlı kipte tahta ekranın üstüne sabitlenir (altındaki satırlar kendi kaydırma
+// bölgesinde akar) ve sonraki karelerde yalnızca değişen kareler imleç konumlandırılarak yazılır.
+// Tahta terminale sığmazsa artımlı kip bırakılır ve her seferinde düz tam çizim basılır.
+class BoardRenderer {
+public:
+    explicit BoardRenderer(std::ostream &out, bool incremental = false);
+    ~BoardRenderer();
+
+    BoardRenderer(const BoardRenderer &) = delete;
+    BoardRenderer &operator=(const BoardRenderer &) = delete;
+
+    void render(const Board &board);
+
+    // Tahtanın tamamını (sütun harfleri ve sıra numaralarıyla) buffer'ın sonuna ekle
+    static void appendFrame(const Board &board, std::string &buffer);
+
+    // Standart çıktı bir terminal mi (artımlı kip yalnızca terminalde anlamlı)
+    static bool isTerminal();
+
+private:
+    std::ostream &out;
+    bool incremental;
+    bool pinned = false;
+    int size = 0;
+    int terminalRows = 0;      // son çizimdeki terminal boyutu
+    int terminalColumns = 0;
+    std::vector<Board::PieceCode> shown;   // ekranda görünen kodlar, MOVED_BIT olmadan
+    std::vector<int> shownSquares;         // ekranda dolu görünen kareler
+    std::string buffer;
+
+    void renderFull(const Board &board);
+    void renderChanges(const Board &board);
+    void flush();
+};
+
+#endif
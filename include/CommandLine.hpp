@@ -0,0 +1,20 @@
+#ifndef COMMAND_LINE_HPP
+#define COMMAND_LINE_HPP
+
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+// Komut satırındaki sayıyı tamamen oku. Boş, sayı olmayan, artık karakter içeren ya da
+// türün aralığı dışındaki değerlerde false döner ve value değişmez.
+template <typename T>
+bool parseNumber(const char *text, T &value) {
+    const char *end = text + std::strlen(text);
+    T parsed{};
+    auto [ptr, ec] = std::from_chars(text, end, parsed);
+    if (ec != std::errc() || ptr == text || ptr != end) return false;
+    value = parsed;
+    return true;
+}
+
+#endif
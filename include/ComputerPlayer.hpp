@@ -0,0 +1,51 @@
+#ifndef COMPUTER_PLAYER_HPP
+#define COMPUTER_PLAYER_HPP
+
+#include "Board.hpp"
+#include "Move.hpp"
+#include "OpeningBook.hpp"
+#include "Search.hpp"
+#include "Tablebase.hpp"
+#include "TranspositionTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Bir renk için bilgisayar oyuncusu: kendi konum tablosu ve arama sınırları vardır
+class ComputerPlayer {
+public:
+    explicit ComputerPlayer(const SearchLimits &limits, std::size_t hashMb = 16);
+
+    // history: oyunda şimdiye kadar oluşan konumların anahtarları (tekrar tespiti için)
+    Move chooseMove(Board &board, const std::vector<std::uint64_t> &history, std::ostream *info = nullptr);
+
+    const SearchResult &lastResult() const { return result; }
+
+    // Yeni oyundan önce konum tablosunu temizle; aynı girdiyle aynı hamleler seçilir
+    void newGame() { tt.clear(); }
+
+    // Kitapta bulunan konumlarda arama yapılmadan kitap hamlesi oynanır
+    void setBook(std::shared_ptr<const OpeningBook> openingBook) { book = std::move(openingBook); }
+
+    // Tablodaki konumlarda tablonun hamlesi oynanır; aramada tabloya inen dallar kesin puanlanır
+    void setTablebase(std::shared_ptr<const Tablebase> tables);
+
+    // "--depth", "--nodes", "--movetime", "--threads", "--hash" komut satırı seçeneklerini oku.
+    // Tanınan seçenek için true döner ve i'yi değerini gösterecek şekilde ilerletir; değer
+    // geçerli bir sayı değilse false döner ve i değişmez.
+    static bool parseOption(int argc, char *argv[], int &i, SearchLimits &limits, std::size_t &hashMb);
+
+private:
+    SearchLimits limits;
+    TranspositionTable tt;
+    Search search;
+    SearchResult result;
+    std::shared_ptr<const OpeningBook> book;
+    std::shared_ptr<const Tablebase> tablebase;
+};
+
+#endif
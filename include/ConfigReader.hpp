@@ -1,7 +1,7 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <nlohmann/json.hpp>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,10 +14,11 @@ struct PieceConfig;
 struct PortalProperties;
 struct PortalConfig;
 struct GameConfig;
+class PieceRegistry;
 
 struct Position {
-  int x;
-  int y;
+  int x = 0;
+  int y = 0;
 };
 
 // Movement capabilities for chess pieces
@@ -43,8 +44,8 @@ struct SpecialAbilities {
 
 struct PieceConfig {
     std::string type;
-    bool isWhite;
-    int count;
+    bool isWhite = false;
+    int count = 0;
 
     std::unordered_map<std::string, std::vector<Position>> positions;
 
@@ -65,9 +66,9 @@ struct PieceConfig {
 
 // Properties for portals
 struct PortalProperties {
-  bool preserve_direction;
+  bool preserve_direction = true;
   std::vector<std::string> allowed_colors;
-  int cooldown;
+  int cooldown = 0;
 };
 
 // Configuration for a portal
@@ -92,6 +93,11 @@ struct GameConfig {
   std::vector<PieceConfig> pieces;
   std::vector<PieceConfig> custom_pieces;
   std::vector<PortalConfig> portals;
+
+  // Piece registry with movement tables compiled ahead of time. Only set when
+  // the config was loaded from a variant snapshot; Board::initialize uses it
+  // instead of rebuilding the tables.
+  std::shared_ptr<const PieceRegistry> compiled_registry;
 };
 
 class ConfigReader {
@@ -99,34 +105,38 @@ public:
   // Constructor
   ConfigReader();
 
-  // Load configuration from a file
+  // Name that selects the standard chess variant built into the binary
+  static constexpr const char *STANDARD_VARIANT = "standard";
+
+  // Largest accepted board_size; square indices must fit Move::SQUARE_BITS
+  static constexpr int MAX_BOARD_SIZE = 4096;
+
+  // Load configuration from a file. Accepts STANDARD_VARIANT, a variant
+  // snapshot, or a JSON file; for JSON an up-to-date snapshot next to it
+  // (VariantSnapshot::pathFor) is used instead of parsing.
   bool loadFromFile(const std::string &filePath);
 
+  // Load configuration from a JSON file, ignoring any snapshot. JSON input
+  // is streamed through a SAX parser straight into GameConfig; no document
+  // tree is built, and errors report their line and column.
+  bool loadFromJsonFile(const std::string &filePath);
+
   // Load configuration from a JSON string
   bool loadFromString(const std::string &jsonString);
 
+  // Load the built-in standard chess variant (no file access)
+  bool loadStandard();
+
   // Get the parsed configuration
   const GameConfig &getConfig() const;
 
   // Validate the configuration
   bool validateConfig();
 
+  // Stable 64-bit hash of everything that affects play (the variant name is
+  // ignored). Game archives store it to detect replay against another variant.
+  static std::uint64_t hashConfig(const GameConfig &config);
+
 private:
   GameConfig m_config;
-
-  // Parse game settings from JSON
-  void parseGameSettings(const nlohmann::json &json);
-
-  // Parse pieces from JSON
-  void parsePieces(const nlohmann::json &json);
-
-  // Parse custom pieces from JSON
-  void parseCustomPieces(const nlohmann::json &json);
-
-  // Parse portals from JSON
-  void parsePortals(const nlohmann::json &json);
-
-  // Parse special abilities from JSON
-  void parseSpecialAbilities(const nlohmann::json &abilities,
-                             SpecialAbilities &specialAbilities);
 };
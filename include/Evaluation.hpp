@@ -0,0 +1,38 @@
+#ifndef EVALUATION_HPP
+#define EVALUATION_HPP
+
+#include "Board.hpp"
+#include "ConfigReader.hpp"
+
+#include <vector>
+
+// Hamle yapan tarafın bakış açısından statik değerlendirme (santipiyon)
+class Evaluation {
+public:
+    static constexpr int PAWN_VALUE = 100;
+
+    // Değer hesabında menzilin sayıldığı en uzun mesafe: 8x8'deki değerler korunur, büyük
+    // tahtalarda uzun menzilli taşların değeri tahta boyuyla büyümez
+    static constexpr int MAX_REACH = 7;
+
+    // evaluate() sonucu [-MAX_SCORE, MAX_SCORE] aralığına kırpılır; mat puanlarının altında kalır
+    static constexpr int MAX_SCORE = 30000;
+
+    explicit Evaluation(const Board &board);
+
+    int evaluate(const Board &board) const;
+
+    // Taş tipinin malzeme değeri; kraliyet taşları için 0
+    int typeValue(int type) const { return values[type]; }
+    int pieceValue(const Board &board, int sq) const { return values[board.typeOf(board.codeAt(sq))]; }
+
+    // Hareket kurallarından türetilen taş değeri (özel taşlar dahil)
+    static int movementValue(const PieceType &type, int boardSize);
+
+private:
+    std::vector<int> values;
+    std::vector<char> pawnLike;
+    std::vector<int> centerBonus;
+};
+
+#endif
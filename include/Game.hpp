@@ -2,18 +2,22 @@
 #define GAME_HPP
 
 #include "Board.hpp"
+#include "BoardRenderer.hpp"
+#include "ComputerPlayer.hpp"
 #include "ConfigReader.hpp"
+#include "GameRecord.hpp"
+#include "MoveValidator.hpp"
 #include "Rules.hpp"
+#include "Tablebase.hpp"
 
 #include <string>
-#include <stack>
-#include <queue>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 struct MoveRecord {
-    int x1, y1, x2, y2;
-    std::unique_ptr<PieceConfig> capturedPiece;
+    Move move;
+    Board::PieceCode capturedPiece;   // alınan taşın kodu, yoksa Board::EMPTY
 };
 
 class Game {
@@ -21,21 +25,41 @@ public:
     Game(const GameConfig& config);
     void start();
 
+    // Verilen rengi bilgisayara oynat
+    void setComputerPlayer(bool isWhite, const SearchLimits& limits, std::size_t hashMb = 16);
+
+    // Bilgisayar oyuncuları aramadan önce bu kitaba bakar
+    void setOpeningBook(std::shared_ptr<const OpeningBook> openingBook);
+
+    // Oyun sonu tabloları: bilgisayar oyuncuları kullanır, mat tespiti tablodan yapılır
+    void setTablebase(std::shared_ptr<const Tablebase> tables);
+
+    // Oynanan oyunu ikili arşive tek oyun olarak yaz
+    bool saveRecord(const std::string& path) const;
+
 private:
     Board board;
+    MoveValidator validator;   // board üzerindeki boş kare bağlantıları
+    BoardRenderer renderer;
     GameConfig config;
     bool isWhiteTurn;
     int turnCount;
 
-    std::stack<MoveRecord> moveHistory;
-    std::queue<std::string> cooldownQueue;
+    std::vector<MoveRecord> moveHistory;
+    GameResult result = GameResult::UNKNOWN;
+    std::vector<std::uint64_t> positionKeys;
+    std::unique_ptr<ComputerPlayer> computers[2];
+    std::shared_ptr<const OpeningBook> book;
+    std::shared_ptr<const Tablebase> tablebase;
 
     bool processMove(const std::string& input);
-    bool parseInput(const std::string& input, int& x1, int& y1, int& x2, int& y2) const;
-    bool checkEndGame() const;
+    bool playComputerMove();
+    void applyMove(Move move);
+    bool parseInput(const std::string& input, int& x1, int& y1, int& x2, int& y2, bool& viaPortal) const;
+    bool checkEndGame();
 
-    void recordMove(int x1, int y1, int x2, int y2, std::unique_ptr<PieceConfig> captured);
-    void handleCooldowns();
+    void recordMove(Move move, Board::PieceCode captured);
+    void announceEnd();
 };
 
 #endif
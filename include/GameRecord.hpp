@@ -0,0 +1,150 @@
+#ifndef GAME_RECORD_HPP
+#define GAME_RECORD_HPP
+
+#include "Move.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// İkili oyun arşivi. Başlık: "CGRC", sürüm, tahta boyu, varyant özeti (ConfigReader::hashConfig)
+// ve oyun sayısı. Her oyun: varint yarım hamle sayısı, sonuç baytı, varint hamle bayt uzunluğu ve
+// her hamle için tek varint (from * kare sayısı + to) * 2 + portaldan devam. Alış, rok, terfi ve
+// portal geçişleri yazılmaz; hamle yeniden oynanırken Rules::findMove ile çıkarılır.
+enum class GameResult : std::uint8_t { UNKNOWN = 0, WHITE_WINS = 1, BLACK_WINS = 2, DRAW = 3 };
+
+struct RecordedMove {
+    int from = 0;
+    int to = 0;
+    bool viaPortal = false;
+};
+
+class GameRecord {
+public:
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 24;
+
+    // Bir oyunun hamlelerini sırayla çözer; arşiv belleğine dokunur, kopyalamaz
+    class MoveCursor {
+    public:
+        MoveCursor(const std::uint8_t *data, const std::uint8_t *end, int squareCount)
+            : data(data), end(end), squareCount(squareCount) {}
+
+        // Sonraki hamle; oyun bittiyse ya da veri bozuksa false
+        bool next(RecordedMove &move);
+
+    private:
+        const std::uint8_t *data;
+        const std::uint8_t *end;
+        int squareCount;
+    };
+
+    struct GameView {
+        std::uint64_t index = 0;
+        GameResult result = GameResult::UNKNOWN;
+        std::uint32_t plies = 0;
+        const std::uint8_t *moves = nullptr;
+        const std::uint8_t *movesEnd = nullptr;
+        int squareCount = 0;
+
+        MoveCursor cursor() const { return MoveCursor(moves, movesEnd, squareCount); }
+    };
+};
+
+// Oyunları akış halinde yazar. Yalnızca yazılmakta olan oyunun hamleleri bellekte tutulur.
+class GameRecordWriter {
+public:
+    GameRecordWriter(const std::string &path, std::uint64_t variantHash, int boardSize);
+    ~GameRecordWriter();
+
+    GameRecordWriter(const GameRecordWriter &) = delete;
+    GameRecordWriter &operator=(const GameRecordWriter &) = delete;
+
+    bool isOpen() const { return out.is_open() && out.good(); }
+
+    void addMove(Move move) { addMove(move.from(), move.to(), (move.flags() & Move::PORTAL) != 0); }
+    void addMove(int from, int to, bool viaPortal);
+    void endGame(GameResult result);
+
+    // Oyun sayısını başlığa yazıp dosyayı kapat
+    bool close();
+
+private:
+    std::ofstream out;
+    std::vector<std::uint8_t> moves;
+    std::vector<std::uint8_t> prefix;
+    std::uint32_t plies = 0;
+    std::uint64_t games = 0;
+    int squareCount;
+};
+
+// Dosyanın salt okunur bellek eşlemesi (mmap). Eşleme nesneyle birlikte yaşar, yıkıcıda kaldırılır;
+// arşiv, kitap, indeks, tablo ve varyant okuyucuları dosyalarını bununla açar.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { unmap(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    // Dosyayı eşle. Açılamazsa, minSize bayttan kısaysa ("<path> is not <what>") ya da eşlenemezse
+    // nedeni error'a yazar ve false döner; önceki eşleme her durumda kaldırılır.
+    bool map(const std::string &path, std::size_t minSize, const std::string &what, std::string &error);
+    void unmap();
+
+    // Çekirdeğe sayfaların sırayla okunacağını bildir
+    void adviseSequential() const;
+
+    const std::uint8_t *data() const { return bytes; }
+    std::size_t size() const { return length; }
+    bool isMapped() const { return bytes != nullptr; }
+
+private:
+    const std::uint8_t *bytes = nullptr;
+    std::size_t length = 0;
+};
+
+// Arşivi belleğe eşler (mmap) ve oyunları kopyalamadan sırayla dolaşır
+class GameRecordReader {
+public:
+    GameRecordReader() = default;
+    ~GameRecordReader();
+
+    GameRecordReader(const GameRecordReader &) = delete;
+    GameRecordReader &operator=(const GameRecordReader &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    const std::string &error() const { return lastError; }
+
+    // Dosya bir oyun arşivi mi (ilk baytlara bakar)
+    static bool isRecordFile(const std::string &path);
+
+    std::uint64_t variantHash() const { return hash; }
+    int boardSize() const { return size; }
+    std::uint64_t gameCount() const { return games; }   // yazıcı kapatılmadıysa 0 olabilir
+
+    // Sonraki oyun; arşiv bittiyse ya da bozuksa false (bozuksa error() dolu)
+    bool next(GameRecord::GameView &game);
+    void rewind() { position = GameRecord::HEADER_SIZE; index = 0; }
+
+    // Oyunun arşiv başından uzaklığı; next()'ten önce çağrılırsa sıradaki oyunun ofseti
+    std::size_t offset() const { return position; }
+    bool seek(std::size_t offset, std::uint64_t gameIndex);
+
+private:
+    MappedFile file;
+    std::size_t position = 0;
+    std::uint64_t index = 0;
+    std::uint64_t hash = 0;
+    std::uint64_t games = 0;
+    int size = 0;
+    std::string lastError;
+};
+
+#endif
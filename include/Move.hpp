@@ -0,0 +1,128 @@
+#ifndef MOVE_HPP
+#define MOVE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 64 bitlik paketlenmiş hamle: [0..23] kaynak kare, [24..47] hedef kare, [48..51] bayraklar.
+// Kare alanı 4096x4096 tahtaya kadar yeter (ConfigReader::MAX_BOARD_SIZE).
+class Move
+{
+public:
+    static constexpr int SQUARE_BITS = 24;
+    static constexpr std::uint64_t SQUARE_MASK = (std::uint64_t(1) << SQUARE_BITS) - 1;
+    static constexpr int MAX_SQUARES = 1 << SQUARE_BITS;
+
+    static constexpr std::uint32_t CAPTURE = 1u << 0;
+    static constexpr std::uint32_t DOUBLE_STEP = 1u << 1;
+    static constexpr std::uint32_t PORTAL = 1u << 2;   // yön koruyan portal çıkışından devam
+
+    // Konum tablosu ve açılış kitabındaki 32 bitlik biçim: [0..13] kaynak, [14..27] hedef,
+    // [28..31] bayraklar. 128x128'e kadar kayıpsızdır; daha büyük tahtalarda kareler alt 14
+    // bitlerine kırpılır. Konum tablosu değeri yasal hamlelerin compact() değeriyle eşleştirir,
+    // açılış kitabı kırpılan bitleri compactHigh() ile ayrıca saklar.
+    static constexpr int COMPACT_SQUARE_BITS = 14;
+    static constexpr std::uint32_t COMPACT_SQUARE_MASK = (1u << COMPACT_SQUARE_BITS) - 1;
+    static constexpr int HIGH_SQUARE_BITS = SQUARE_BITS - COMPACT_SQUARE_BITS;
+    static constexpr std::uint32_t HIGH_SQUARE_MASK = (1u << HIGH_SQUARE_BITS) - 1;
+
+    constexpr Move() : data(0) {}
+    constexpr Move(int from, int to, std::uint32_t flags = 0)
+        : data(static_cast<std::uint64_t>(from) | (static_cast<std::uint64_t>(to) << SQUARE_BITS) |
+               (static_cast<std::uint64_t>(flags) << (2 * SQUARE_BITS))) {}
+
+    constexpr int from() const { return static_cast<int>(data & SQUARE_MASK); }
+    constexpr int to() const { return static_cast<int>((data >> SQUARE_BITS) & SQUARE_MASK); }
+    constexpr std::uint32_t flags() const { return static_cast<std::uint32_t>(data >> (2 * SQUARE_BITS)); }
+    constexpr bool isCapture() const { return (flags() & CAPTURE) != 0; }
+
+    constexpr std::uint32_t compact() const {
+        return (static_cast<std::uint32_t>(from()) & COMPACT_SQUARE_MASK) |
+               ((static_cast<std::uint32_t>(to()) & COMPACT_SQUARE_MASK) << COMPACT_SQUARE_BITS) |
+               (flags() << (2 * COMPACT_SQUARE_BITS));
+    }
+
+    // compact()'ın kırptığı üst kare bitleri: [0..9] kaynak, [10..19] hedef
+    constexpr std::uint32_t compactHigh() const {
+        return (static_cast<std::uint32_t>(from()) >> COMPACT_SQUARE_BITS) |
+               ((static_cast<std::uint32_t>(to()) >> COMPACT_SQUARE_BITS) << HIGH_SQUARE_BITS);
+    }
+
+    // compact() ve compactHigh() çiftinden hamleyi geri kur
+    static constexpr Move fromCompact(std::uint32_t compact, std::uint32_t high) {
+        int from = static_cast<int>((compact & COMPACT_SQUARE_MASK) |
+                                    ((high & HIGH_SQUARE_MASK) << COMPACT_SQUARE_BITS));
+        int to = static_cast<int>(((compact >> COMPACT_SQUARE_BITS) & COMPACT_SQUARE_MASK) |
+                                  (((high >> HIGH_SQUARE_BITS) & HIGH_SQUARE_MASK) << COMPACT_SQUARE_BITS));
+        return Move(from, to, compact >> (2 * COMPACT_SQUARE_BITS));
+    }
+
+    constexpr bool isNone() const { return data == 0; }
+
+    constexpr bool operator==(const Move &other) const { return data == other.data; }
+    constexpr bool operator!=(const Move &other) const { return data != other.data; }
+
+private:
+    std::uint64_t data;
+};
+
+// Hamle listesi: ilk CAPACITY hamle yığında tutulur, dolunca liste öbeğe taşınır.
+// Çok büyük tahtalarda uzun menzilli taşlar bu sınırı aşabilir; hiçbir hamle düşürülmez.
+class MoveList
+{
+public:
+    static constexpr std::size_t CAPACITY = 2048;
+
+    MoveList() = default;
+    MoveList(const MoveList &other) { *this = other; }
+
+    MoveList &operator=(const MoveList &other) {
+        if (this == &other) return *this;
+        count = 0;
+        for (const Move &move : other) push(move);
+        return *this;
+    }
+
+    void push(const Move &move) {
+        if (count == capacity) grow();
+        items[count++] = move;
+    }
+
+    void clear() { count = 0; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move &operator[](std::size_t i) { return items[i]; }
+    const Move &operator[](std::size_t i) const { return items[i]; }
+
+    Move *begin() { return items; }
+    Move *end() { return items + count; }
+    const Move *begin() const { return items; }
+    const Move *end() const { return items + count; }
+
+    bool contains(const Move &move) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (items[i] == move) return true;
+        }
+        return false;
+    }
+
+private:
+    void grow() {
+        if (spill.empty()) spill.assign(items, items + count);
+        spill.resize(capacity * 2);
+        items = spill.data();
+        capacity = spill.size();
+    }
+
+    std::array<Move, CAPACITY> inlineMoves;
+    std::vector<Move> spill;   // yığındaki kapasite aşılınca kullanılan depo
+    Move *items = inlineMoves.data();
+    std::size_t capacity = CAPACITY;
+    std::size_t count = 0;
+};
+
+#endif
@@ -1,21 +1,60 @@
 #pragma once
 
 #include "Board.hpp"
-#include <unordered_map>
+#include <array>
+#include <cstdint>
 #include <vector>
-#include <queue>
 
+// Boş karelerin 8 yönlü bağlantı bileşenlerini union-find ile tutar. Tahtaya bağlı
+// kalır; her hamleden sonra değişen kareler update() ile bildirilir, yol sorguları
+// birkaç find çağrısına iner. Yeniden kurulum tahtanın doluluk karolarını kullanır:
+// taşsız bir karo tek düğümdür, yalnızca taşlı karolar kare kare birleştirilir.
 class MoveValidator {
 public:
     MoveValidator(const Board& board);
+
+    // from'dan boş kareler üzerinden to'ya ulaşılabiliyor mu (to boş olmalı)
     bool isPathValid(const Position& from, const Position& to);
 
+    // sq karesinin doluluğu tahtada değiştiyse bileşenleri güncelle
+    void update(int sq);
+
+    // Tüm bileşenleri tahtadan yeniden kur
+    void rebuild();
+
 private:
-    void buildGraph();
-    bool bfs(const Position& start, const Position& target);
+    static constexpr int NO_NEIGHBOR = -1;
 
     const Board& board;
-    std::unordered_map<std::string, std::vector<Position>> adjacencyList;
+    int squareCount = 0;
+
+    // Boş kare bit kümesi; bileşenlerin bildiği son durum
+    std::vector<std::uint64_t> empty;
+
+    // Union-find düğümleri; boşalan kareye her seferinde yeni düğüm verilir, böylece
+    // dolan karenin eski düğümü diğer karelerin ağacını bozmadan yerinde kalır
+    std::vector<int> parent;
+    std::vector<int> rank;
+    std::vector<int> node;
+
+    // Bölünme taşkınında kullanılan geçici alanlar
+    std::vector<std::uint64_t> visited;
+    std::vector<int> stack;
+
+    // Komşu kareler saat yönünde (8 yön, tahta dışı NO_NEIGHBOR)
+    std::array<int, 8> ring(int sq) const;
+
+    bool isEmpty(int sq) const { return (empty[sq >> 6] >> (sq & 63)) & 1; }
+    void setEmpty(int sq, bool value);
+
+    int newNode();
+    int find(int n);
+    void unite(int a, int b);
+
+    // n düğümünü sq'nun zaten boş işaretlenmiş komşularıyla birleştir
+    void uniteEmptyNeighbors(int sq, int n);
 
-    std::string posToKey(const Position& pos) const;
+    void vacate(int sq);
+    void occupy(int sq);
+    void relabel(int start);
 };
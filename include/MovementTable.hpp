@@ -0,0 +1,80 @@
+#ifndef MOVEMENT_TABLE_HPP
+#define MOVEMENT_TABLE_HPP
+
+#include "Bitboard.hpp"
+#include "ConfigReader.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Bir taş tipinin bir renk için derlenmiş hareketi. Movement alanları yükleme sırasında bir kez
+// yorumlanır; hamle üretimi, doğrulama ve saldırı haritası yalnızca bu tabloları dolaşır.
+// MAX_TABLE_SQUARES'a kadar her kare için ışınlar tabloda durur. Daha büyük tahtalarda kare
+// başına tablo tutulmaz: yön başına menziller saklanır ve ışın tahta kenarıyla sorguda kırpılır.
+class MovementTable {
+public:
+    static constexpr int MAX_TABLE_SQUARES = 128 * 128;
+    static constexpr std::uint16_t NO_DOUBLE_STEP = 0xFFFF;
+
+    // Kare başına yön başına en fazla bir ışın; i. kare begin + (i + 1) * step.
+    // Üye ilklendiricisi yoktur: basit (trivial) tip olduğundan diziler tek kopyayla taşınır.
+    struct Ray {
+        int begin;                        // ışının çıktığı kare
+        int step;                         // bir adımın kare indeksindeki karşılığı
+        std::uint16_t moveLength;         // bu mesafeye kadar boş karelere gidilebilir
+        std::uint16_t captureLength;      // bu mesafeye kadar rakip taş alınabilir
+        std::uint16_t doubleStepFrom;     // bu sıradan itibaren sessiz hamleler DOUBLE_STEP
+        std::uint16_t moveReach;          // tahta kenarıyla kırpılmamış menziller (portaldan
+        std::uint16_t captureReach;       // devam eden hamleler kenarın ötesini kullanır)
+
+        int length() const { return std::max(moveLength, captureLength); }
+    };
+
+    MovementTable(const PieceConfig &piece, int color, int boardSize);
+
+    // Önceden derlenmiş tablodan kur (VariantSnapshot); rays tahta boyutuna göre kare başına
+    // tablo ya da yön başına menzillerdir
+    MovementTable(int color, int boardSize, std::vector<Ray> rays, std::vector<int> leaps, std::vector<int> leapStart);
+
+    Ray ray(int sq, int dir) const {
+        if (!perDirection) return rays[static_cast<std::size_t>(sq) * DIRECTION_COUNT + dir];
+        return clippedRay(sq, dir);
+    }
+
+    // ray'in i. karesi (0 en yakın)
+    int target(const Ray &r, int i) const { return r.begin + (i + 1) * r.step; }
+
+    // L hamlesi hedefleri (hem gidiş hem alış); L hamlesi olmayan taşlarda tablo tutulmaz
+    const int *leapsBegin(int sq) const { return leapStart.empty() ? leaps.data() : leaps.data() + leapStart[sq]; }
+    const int *leapsEnd(int sq) const { return leapStart.empty() ? leaps.data() : leaps.data() + leapStart[sq + 1]; }
+
+    // Kare başına ışın tablosu tutulmuyorsa true
+    bool isPerDirection() const { return perDirection; }
+
+    // Ham diziler; anlık görüntüye yazmak için
+    const std::vector<Ray> &rayData() const { return rays; }
+    const std::vector<int> &leapData() const { return leaps; }
+    const std::vector<int> &leapStartData() const { return leapStart; }
+
+    // Tahta boyutuna göre rayData uzunluğu
+    static std::size_t rayCount(int boardSize);
+
+private:
+    int boardSize = 0;
+    int startRank = 0;             // piyonun çift adım sırası
+    bool perDirection = false;
+
+    // Kare başına tabloda squareCount * DIRECTION_COUNT ışın. Yön başına kipte 2 * DIRECTION_COUNT
+    // kırpılmamış ışın: önce diğer sıralar, sonra startRank (begin ve step sorguda doldurulur)
+    std::vector<Ray> rays;
+    std::vector<int> leaps;
+    std::vector<int> leapStart;
+
+    // Kırpılmamış ışını sq karesine yerleştirip tahta kenarıyla kırp
+    Ray clip(Ray ray, int sq, int dir) const;
+    Ray clippedRay(int sq, int dir) const;
+};
+
+#endif
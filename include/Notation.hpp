@@ -0,0 +1,34 @@
+#ifndef NOTATION_HPP
+#define NOTATION_HPP
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Kare ve hamle gösterimi: sütun harfleri + (board_size - y). 26 sütundan geniş tahtalarda
+// sütunlar çok harflidir (z, aa, ab, ..., zz, aaa). Yön koruyan portaldan devam eden hamlelerin
+// sonuna '*' eklenir; aynı kareye doğrudan giden hamleden böyle ayrılırlar.
+class Notation {
+public:
+    static std::string fileToString(int x);
+    static std::string squareToString(int x, int y, int boardSize);
+    static std::string moveToString(const Board &board, Move move);
+
+    // "e2e4" biçimini (sütun birden çok harfli, sıra birden çok basamaklı olabilir: "ab120ac121")
+    // tahta koordinatlarına çevir.
+    // Bellek ayırmaz; biçim bozuksa ya da kare tahta dışındaysa false döner.
+    // viaPortal verilmezse '*' ekli hamleler reddedilir.
+    static bool parseSquare(std::string_view text, int boardSize, int &x, int &y);
+    static bool parseMove(std::string_view text, int boardSize, int &x1, int &y1, int &x2, int &y2,
+                          bool *viaPortal = nullptr);
+
+    // Hamleleri board üzerinde sırayla oyna. Gösterimi bozuk, sıradaki tarafın yapamayacağı ya da
+    // kendi royal taşını tehdit altında bırakan ilk hamlede durur, nedenini error'a yazar ve false
+    // döner; o ana kadarki hamleler oynanmış kalır.
+    static bool playMoves(Board &board, const std::vector<std::string> &moves, std::string &error);
+};
+
+#endif
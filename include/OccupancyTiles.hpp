@@ -0,0 +1,128 @@
+#ifndef OCCUPANCY_TILES_HPP
+#define OCCUPANCY_TILES_HPP
+
+#include "Bitboard.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// Tahtanın 8x8 karolara bölünmüş doluluk haritası: karo başına 64 bitlik maske ve dolu
+// karoların listesi. Büyük ve seyrek tahtalarda dolu karelerin dolaşılması yalnızca dolu
+// karolara, bir doğru boyunca ilk taşın aranması ise boş karoların tek adımda atlanmasına iner.
+class OccupancyTiles {
+public:
+    static constexpr int TILE_SHIFT = 3;
+    static constexpr int TILE_SIZE = 1 << TILE_SHIFT;
+    static constexpr int TILE_MASK = TILE_SIZE - 1;
+
+    OccupancyTiles() = default;
+
+    explicit OccupancyTiles(int boardSize)
+        : board_size(boardSize), tilesPerRow((boardSize + TILE_MASK) >> TILE_SHIFT) {
+        masks.assign(static_cast<std::size_t>(tilesPerRow) * tilesPerRow, 0);
+        slot.assign(masks.size(), -1);
+    }
+
+    int tileCount() const { return static_cast<int>(masks.size()); }
+    int tilesPerSide() const { return tilesPerRow; }
+    int tileOf(int x, int y) const { return (y >> TILE_SHIFT) * tilesPerRow + (x >> TILE_SHIFT); }
+    static int bitOf(int x, int y) { return ((y & TILE_MASK) << TILE_SHIFT) | (x & TILE_MASK); }
+
+    std::uint64_t mask(int tile) const { return masks[tile]; }
+    bool test(int sq) const {
+        int x = sq % board_size, y = sq / board_size;
+        return (masks[tileOf(x, y)] >> bitOf(x, y)) & 1;
+    }
+
+    // Kare indeksi (y * board_size + x) ile
+    void set(int sq) {
+        int x = sq % board_size, y = sq / board_size;
+        int tile = tileOf(x, y);
+        if (masks[tile] == 0) {
+            slot[tile] = static_cast<int>(occupied.size());
+            occupied.push_back(tile);
+        }
+        masks[tile] |= std::uint64_t(1) << bitOf(x, y);
+    }
+
+    void reset(int sq) {
+        int x = sq % board_size, y = sq / board_size;
+        int tile = tileOf(x, y);
+        masks[tile] &= ~(std::uint64_t(1) << bitOf(x, y));
+        if (masks[tile] != 0) return;
+        int last = occupied.back();
+        occupied[slot[tile]] = last;
+        slot[last] = slot[tile];
+        occupied.pop_back();
+        slot[tile] = -1;
+    }
+
+    // En az bir taşı olan karolar (sırasız)
+    const std::vector<int> &occupiedTiles() const { return occupied; }
+
+    // Dolu karoların karelerini kare indeksiyle (y * board_size + x) ziyaret et
+    template <typename Visit>
+    void forEachOccupied(Visit &&visit) const {
+        for (int tile : occupied) {
+            int baseX = (tile % tilesPerRow) << TILE_SHIFT;
+            int baseY = (tile / tilesPerRow) << TILE_SHIFT;
+            for (std::uint64_t bits = masks[tile]; bits; bits &= bits - 1) {
+                int bit = std::countr_zero(bits);
+                visit((baseY + (bit >> TILE_SHIFT)) * board_size + baseX + (bit & TILE_MASK));
+            }
+        }
+    }
+
+    // sq'dan dir yönünde (sq hariç) ilk dolu kare; bulunursa uzaklığı distance'a yazılır ve
+    // kare indeksi döner, tahta kenarına kadar boşsa -1
+    int firstOccupied(int sq, int dir, int &distance) const {
+        int x = sq % board_size;
+        int y = sq / board_size;
+        int dx = DIRECTION_DX[dir];
+        int dy = DIRECTION_DY[dir];
+        const std::uint64_t *tiles = masks.data();
+        int steps = 1;
+        x += dx;
+        y += dy;
+        while (x >= 0 && x < board_size && y >= 0 && y < board_size) {
+            int tx = x >> TILE_SHIFT;
+            int ty = y >> TILE_SHIFT;
+            std::uint64_t bits = tiles[ty * tilesPerRow + tx];
+            if (bits == 0) {
+                // Karonun kenarına kadar olan kareler boş: doğrudan sonraki karoya geç
+                int skip = TILE_SIZE;
+                if (dx > 0) skip = std::min(skip, TILE_SIZE - (x & TILE_MASK));
+                if (dx < 0) skip = std::min(skip, (x & TILE_MASK) + 1);
+                if (dy > 0) skip = std::min(skip, TILE_SIZE - (y & TILE_MASK));
+                if (dy < 0) skip = std::min(skip, (y & TILE_MASK) + 1);
+                x += skip * dx;
+                y += skip * dy;
+                steps += skip;
+                continue;
+            }
+            // Karo içinde kare kare ilerle; karodan çıkınca sonraki karonun maskesi okunur
+            do {
+                if ((bits >> (((y & TILE_MASK) << TILE_SHIFT) | (x & TILE_MASK))) & 1) {
+                    distance = steps;
+                    return y * board_size + x;
+                }
+                x += dx;
+                y += dy;
+                ++steps;
+            } while (x >= 0 && x < board_size && y >= 0 && y < board_size && (x >> TILE_SHIFT) == tx &&
+                     (y >> TILE_SHIFT) == ty);
+        }
+        return -1;
+    }
+
+private:
+    int board_size = 0;
+    int tilesPerRow = 0;
+    std::vector<std::uint64_t> masks;
+    std::vector<int> occupied;   // maskesi boş olmayan karolar
+    std::vector<int> slot;       // karo -> occupied içindeki sırası
+};
+
+#endif
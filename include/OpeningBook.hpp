@@ -0,0 +1,86 @@
+#ifndef OPENING_BOOK_HPP
+#define OPENING_BOOK_HPP
+
+#include "Board.hpp"
+#include "GameRecord.hpp"
+#include "Move.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Konum anahtarı (Board::key) ve hamle başına oyun sayısı ve sonuçlar. Diskte "CBOK" başlığı
+// (sürüm, varyant özeti, giriş sayısı) ve ardından anahtara göre sıralı girişler bulunur.
+// Okuyucu dosyayı belleğe eşler (mmap); sorgular ikili arama yapar ve bellek ayırmaz.
+class OpeningBook {
+public:
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 32;
+
+    struct Entry {
+        std::uint64_t key;
+        std::uint32_t move;     // Move::compact(), bayraklarıyla
+        std::uint32_t games;
+        std::uint32_t wins;     // hamleyi yapan taraf açısından
+        std::uint32_t draws;
+        std::uint32_t losses;
+        std::uint32_t moveHigh; // Move::compactHigh(); 128x128'e kadar 0
+
+        Move toMove() const { return Move::fromCompact(move, moveHigh); }
+
+        // Sonucu bilinen oyunlarda hamleyi yapanın puan oranı (binde)
+        int score() const {
+            std::uint32_t decided = wins + draws + losses;
+            return decided == 0 ? 500 : static_cast<int>((2000ull * wins + 1000ull * draws) / (2 * decided));
+        }
+    };
+    static_assert(sizeof(Entry) == 32, "book entries are written as-is");
+
+    struct BuildOptions {
+        int maxPly = 16;     // her oyunun yalnızca ilk maxPly yarım hamlesi
+        int minGames = 2;    // daha az oynanmış hamleler kitaba girmez
+        int jobs = 1;
+    };
+
+    struct BuildStats {
+        std::uint64_t games = 0;
+        std::uint64_t skippedGames = 0;   // bu varyantta oynanamayan hamlesi olan oyunlar
+        std::uint64_t moves = 0;
+        std::uint64_t entries = 0;
+    };
+
+    // Arşivlerdeki oyunların açılışlarını start konumundan oynayıp kitabı bookPath'e yaz
+    static bool build(const Board &start, std::uint64_t variantHash, const std::vector<std::string> &archivePaths,
+                      const std::string &bookPath, const BuildOptions &options, BuildStats &stats,
+                      std::string &error);
+
+    OpeningBook() = default;
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook &) = delete;
+    OpeningBook &operator=(const OpeningBook &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    const std::string &error() const { return lastError; }
+
+    std::uint64_t variantHash() const { return hash; }
+    std::uint64_t size() const { return count; }
+
+    // key konumunun tüm girişleri [first, second)
+    std::pair<const Entry *, const Entry *> find(std::uint64_t key) const;
+
+    // Konumda en çok oynanmış (eşitlikte puanı yüksek) yasal kitap hamlesi, yoksa boş hamle
+    Move probe(Board &board) const;
+
+private:
+    MappedFile file;
+    const Entry *entries = nullptr;
+    std::uint64_t count = 0;
+    std::uint64_t hash = 0;
+    std::string lastError;
+};
+
+#endif
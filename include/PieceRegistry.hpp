@@ -0,0 +1,64 @@
+#ifndef PIECE_REGISTRY_HPP
+#define PIECE_REGISTRY_HPP
+
+#include "ConfigReader.hpp"
+#include "MovementTable.hpp"
+#include "StandardKernel.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Bir taş tipinin değişmez bilgisi; tahtada yalnızca tip numarası tutulur
+struct PieceType {
+    std::string name;
+    char symbol = '?';
+    Movement movement;
+    std::uint64_t abilities = 0;   // PieceRegistry::Ability bitleri ve özel yetenekler
+    StandardKernel::Kind kind = StandardKernel::NONE;
+    std::unique_ptr<const MovementTable> moves[2];
+
+    bool has(std::uint64_t ability) const { return (abilities & ability) != 0; }
+};
+
+// Yapılandırmadaki taş tiplerinin kaydı. Tahta kurulurken bir kez oluşturulur ve tahtanın
+// tüm kopyaları tarafından paylaşılır; tip adı karşılaştırmaları yalnızca burada yapılır.
+class PieceRegistry {
+public:
+    enum Ability : std::uint64_t {
+        CASTLING = 1ull << 0,
+        ROYAL = 1ull << 1,
+        JUMP_OVER = 1ull << 2,
+        PROMOTION = 1ull << 3,
+        EN_PASSANT = 1ull << 4,
+        PAWN_MOVES = 1ull << 5,   // yalnızca ileri giden, çapraz alan piyon hareketi
+    };
+    static constexpr int CUSTOM_SHIFT = 8;
+
+    // compiled boş değilse tip başına beyaz ve siyah tablolar kayıt sırasıyla oradan alınır
+    PieceRegistry(const std::vector<PieceConfig> &pieces, int boardSize, std::vector<MovementTable> compiled = {});
+    explicit PieceRegistry(const GameConfig &config);
+
+    int size() const { return static_cast<int>(types.size()); }
+    const PieceType &type(int id) const { return types[id]; }
+
+    // Adı verilen tipin numarası, yoksa -1
+    int find(const std::string &name) const;
+
+    // Özel yeteneğin biti, tanınmıyorsa 0
+    std::uint64_t customAbility(const std::string &name) const;
+
+    // Tüm tipler standart 8x8 takıma uyuyorsa türlere göre tip numaraları
+    bool usesStandardKernel() const { return standardKernel; }
+    const std::array<int, StandardKernel::KIND_COUNT> &standardTypes() const { return kernelTypes; }
+
+private:
+    std::vector<PieceType> types;
+    std::vector<std::string> customAbilityNames;
+    bool standardKernel = false;
+    std::array<int, StandardKernel::KIND_COUNT> kernelTypes{};
+};
+
+#endif
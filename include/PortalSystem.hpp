@@ -1,39 +1,97 @@
 #ifndef PORTALSYSTEM_HPP
 #define PORTALSYSTEM_HPP
 
-#include "Position.hpp"
+#include "Bitboard.hpp"
+#include "ConfigReader.hpp"
+#include <cstdint>
+#include <string>
 #include <vector>
-#include <unordered_map>
-#include <queue>
-
-struct Portal
-{
-    Position entry;
-    Position exit;
-    bool isTwoWay;
-};
-
-struct CooldownEntry {
-    Position portalEntry;
-    int remainingTurns;
-};
 
+// Tahtadaki portalların kare indeksli tablosu ve bekleme süreleri.
+// Renkler Board ile aynı numaralanır: 0 beyaz, 1 siyah.
 class PortalSystem
 {
 public:
-    PortalSystem();
+    PortalSystem() = default;
+    PortalSystem(const std::vector<PortalConfig>& portals, int boardSize);
+
+    int count() const { return static_cast<int>(configs.size()); }
+    const PortalConfig& config(int portal) const { return configs[portal]; }
+    const std::vector<PortalConfig>& configList() const { return configs; }
+
+    int entrySquare(int portal) const { return entries[portal]; }
+    int exitSquare(int portal) const { return exits[portal]; }
+
+    // sq karesinden giren ilk portal, yoksa -1; aynı girişteki diğerleri nextAtEntry ile
+    int firstAtEntry(int sq) const { return entryHead.empty() ? -1 : entryHead[sq]; }
+    int nextAtEntry(int portal) const { return entryNext[portal]; }
+    bool isEntry(int sq) const { return firstAtEntry(sq) >= 0; }
+
+    // sq karesine çıkan ilk portal, yoksa -1; diğerleri nextAtExit ile
+    int firstAtExit(int sq) const { return exitHead.empty() ? -1 : exitHead[sq]; }
+    int nextAtExit(int portal) const { return exitNext[portal]; }
+
+    // preserve_direction: kayan taş çıkıştan aynı yönde kalan menzili kadar devam edebilir
+    bool preservesDirection(int portal) const { return configs[portal].properties.preserve_direction; }
+    bool hasContinuations() const { return continuations; }
+
+    // sq'dan d yönündeki doğru üzerinde yön koruyan bir giriş varsa d. bit açık
+    std::uint8_t continuationDirections(int sq) const { return continuationDirs.empty() ? 0 : continuationDirs[sq]; }
+
+    // color rengindeki bir taş portal üzerinden sq'ya ulaşabilir mi (doluluk ve bekleme
+    // süresinden bağımsız): sq bir çıkış ya da yön koruyan bir çıkışla aynı doğrultuda
+    bool isExposed(int sq, int color) const { return !exposure.empty() && ((exposure[sq] >> color) & 1); }
 
-    void addPortal(const Position& entry, const Position& exit, bool isTwoWay);
-    bool canUsePortal(const Position& pos) const;
-    Position getTeleportExit(const Position& entry, const Position& direction) const;
-    void applyCooldown(const Position& entry);
-    void decrementCooldowns();
-    bool isOnCooldown(const Position& pos) const;
+    bool allows(int portal, int color) const { return (colorMask[portal] >> color) & 1; }
+
+    // Portal ply < cooldownUntil olduğu sürece kullanılamaz
+    bool isReady(int portal, int ply) const { return ply >= cooldownUntil[portal]; }
+    int cooldownEnd(int portal) const { return cooldownUntil[portal]; }
+
+    // ply'de kullanılan portalın beklemesini başlat; önceki bitiş plysini döndürür
+    int startCooldown(int portal, int ply);
+    // startCooldown'ı geri al (ply hâlâ kullanım anındaki değerde olmalı)
+    void restoreCooldown(int portal, int previousUntil);
+
+    // Beklemenin bitişini doğrudan ayarla (ply şimdiki yarım hamle; tablo konumları için)
+    void setCooldown(int portal, int until, int ply);
+
+    // Ply sayacı ilerlerken/gerilerken süresi dolan beklemeleri etkin listeden çıkar/geri koy
+    void tick(int ply);
+    void untick(int ply);
+
+    // Beklemesi süren portallar; en fazla (en uzun bekleme + 1) kadar olabilir
+    const std::vector<int>& activeCooldowns() const { return active; }
 
 private:
-    std::vector<Portal> portals;
-    std::unordered_map<Position, Portal> portalMap;
-    std::queue<CooldownEntry> cooldownQueue;
+    std::vector<PortalConfig> configs;
+    std::vector<int> entries;
+    std::vector<int> exits;
+    std::vector<std::uint8_t> colorMask;
+
+    // Kare -> o kareden giren ilk portal, portal -> aynı girişteki sonraki portal
+    std::vector<int> entryHead;
+    std::vector<int> entryNext;
+    std::vector<int> exitHead;
+    std::vector<int> exitNext;
+
+    bool continuations = false;
+    std::vector<std::uint8_t> exposure;
+    std::vector<std::uint8_t> continuationDirs;
+
+    std::vector<int> cooldownUntil;
+
+    // Zaman çarkı: wheel[bitiş % boyut] o plyde süresi dolan portallar
+    std::vector<std::vector<int>> wheel;
+    int wheelMask = 0;
+
+    std::vector<int> active;
+    std::vector<int> activeIndex;
+
+    void addActive(int portal);
+    void removeActive(int portal);
+    void addToWheel(int portal);
+    void removeFromWheel(int portal);
 };
 
 #endif
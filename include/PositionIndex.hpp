@@ -0,0 +1,75 @@
+#ifndef POSITION_INDEX_HPP
+#define POSITION_INDEX_HPP
+
+#include "Board.hpp"
+#include "GameRecord.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+// Oyun arşivinde ulaşılan her konumun (Board::key) hangi oyunun kaçıncı yarım hamlesinde
+// görüldüğü. Girişler anahtara, sonra oyuna ve yarım hamleye göre sıralıdır.
+struct PositionEntry {
+    std::uint64_t key;
+    std::uint32_t game;
+    std::uint32_t ply;   // 0 = başlangıç konumu
+
+    bool operator<(const PositionEntry &other) const {
+        if (key != other.key) return key < other.key;
+        if (game != other.game) return game < other.game;
+        return ply < other.ply;
+    }
+};
+static_assert(sizeof(PositionEntry) == 16, "index entries are written as-is");
+
+// Diskteki dizin: "CPIX" başlığı (sürüm, varyant özeti, giriş ve oyun sayısı) ve ardından
+// sıralı girişler, makinenin bayt sırasıyla. Okuyucu dosyayı belleğe eşler (mmap) ve
+// ikili arama yapar; sorgu bellek ayırmaz.
+class PositionIndex {
+public:
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 32;
+
+    struct BuildStats {
+        std::uint64_t games = 0;
+        std::uint64_t positions = 0;
+        std::uint64_t skippedGames = 0;   // arşivdeki hamlesi bu varyantta oynanamayan oyunlar
+        int runs = 0;
+    };
+
+    // archivePath'teki oyunları start konumundan oynayıp dizini indexPath'e yaz. Oyunlar jobs iş
+    // parçacığında oynanır; her biri kendi payına düşen bellek dolunca girişlerini sıralayıp geçici
+    // bir dosyaya yazar, sonunda bu dosyalar tek geçişte birleştirilir (dış sıralama).
+    static bool build(const Board &start, std::uint64_t variantHash, const std::string &archivePath,
+                      const std::string &indexPath, int jobs, std::size_t memoryMb, BuildStats &stats,
+                      std::string &error);
+
+    PositionIndex() = default;
+    ~PositionIndex();
+
+    PositionIndex(const PositionIndex &) = delete;
+    PositionIndex &operator=(const PositionIndex &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    const std::string &error() const { return lastError; }
+
+    std::uint64_t variantHash() const { return hash; }
+    std::uint64_t size() const { return count; }
+    std::uint64_t gameCount() const { return games; }
+
+    // key konumunun tüm girişleri [first, second)
+    std::pair<const PositionEntry *, const PositionEntry *> find(std::uint64_t key) const;
+
+private:
+    MappedFile file;
+    const PositionEntry *entries = nullptr;
+    std::uint64_t count = 0;
+    std::uint64_t games = 0;
+    std::uint64_t hash = 0;
+    std::string lastError;
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "Board.hpp"
 #include "ConfigReader.hpp"
+#include "Move.hpp"
 
 #include <vector>
 #include <unordered_map>
@@ -10,16 +11,42 @@
 class Rules {
 public:
     static bool isCheck(const Board& board, bool isWhiteTurn);
-    static bool isCheckmate(const Board& board, bool isWhiteTurn);
+    static bool isCheckmate(Board& board, bool isWhiteTurn);
     static bool isValidMove(const Board& board, int x1, int y1, int x2, int y2);
 
+    // from'dan to'ya giden sözde yasal hamle (bayraklarıyla), yoksa boş hamle.
+    // viaPortal yalnızca yön koruyan portaldan devam eden hamleyi seçer; verilmezse doğrudan hamle
+    // tercih edilir, yoksa portaldan devam eden hamle döner.
+    static Move findMove(const Board& board, int from, int to, bool viaPortal = false);
+
+    // Sözde yasal hamle oynandığında hamleyi yapanın royal taşı tehdit altında kalıyor mu.
+    // Hamle yerinde yapılıp geri alınır; tahta aynı kalır.
+    static bool leavesRoyalInCheck(Board& board, Move move);
+
+    // findLegalMove'un hamleyi reddetme nedeni
+    enum class MoveError { NONE, NO_PIECE, WRONG_SIDE, NOT_A_MOVE, LEAVES_ROYAL_IN_CHECK };
+
+    // from'dan to'ya giden yasal hamle: taş sıradaki tarafın, hamle sözde yasal ve royal taşı
+    // tehdit altında bırakmıyor. Değilse boş hamle döner, neden error'a yazılır; tahta aynı kalır.
+    static Move findLegalMove(Board& board, int from, int to, bool viaPortal = false, MoveError* error = nullptr);
+
     static bool canCastle(const Board& board, int kingX, int kingY, bool isLeft);
     static bool isMoveBlocked(const Board& board, int x1, int y1, int x2, int y2);
     static bool violatesCustomRule(const Board& board, const PieceConfig& piece, int x2, int y2);
 
-    static std::vector<std::pair<int, int>> getReachablePositions(const Board& board, int x, int y);
+    static std::vector<std::pair<int, int>> getReachablePositions(Board& board, int x, int y);
     static bool isKingSurrounded(const Board& board, bool isWhiteTurn);
 
+    // Hamle üretimi: isValidMove ile aynı kurallar, kral güvenliği kontrol/açmaz maskeleriyle.
+    // Board& alan fonksiyonlar varsayımsal hamleleri yerinde yapıp geri alır; tahta aynı kalır.
+    static void generatePseudoLegalMoves(const Board& board, bool isWhiteTurn, MoveList& moves);
+    static void generateLegalMoves(Board& board, bool isWhiteTurn, MoveList& moves);
+    static bool hasAnyLegalMove(Board& board, bool isWhiteTurn);
+
+    // sq karesi byWhite rengindeki bir taş tarafından tehdit ediliyor mu.
+    // ignoreSq boş sayılır, skipSq üzerindeki taş saldırgan olarak yok sayılır.
+    static bool isSquareAttacked(const Board& board, int sq, bool byWhite, int ignoreSq = -1, int skipSq = -1);
+
 private:
     static bool isPathClear(const Board& board, int x1, int y1, int x2, int y2);
     static bool threatensKing(const Board& board, const PieceConfig& attacker, int x, int y);
@@ -0,0 +1,100 @@
+#ifndef SEARCH_HPP
+#define SEARCH_HPP
+
+#include "Board.hpp"
+#include "Evaluation.hpp"
+#include "Move.hpp"
+#include "Tablebase.hpp"
+#include "TranspositionTable.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+struct SearchLimits {
+    int maxDepth = 64;
+    std::uint64_t maxNodes = 0;   // 0 = sınırsız
+    int moveTimeMs = 0;           // 0 = sınırsız
+    int threads = 1;              // 1'den fazlaysa yardımcı iş parçacıkları (Lazy SMP)
+};
+
+struct SearchResult {
+    Move bestMove;
+    int score = 0;
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    double seconds = 0.0;
+};
+
+// Yinelemeli derinleştirmeli alfa-beta (negamax) arama. threads > 1 olduğunda yardımcı
+// iş parçacıkları aynı kökü kendi tahta kopyalarında arar; aralarında yalnızca konum
+// tablosu ve durdurma bayrağı paylaşılır (Lazy SMP).
+class Search {
+public:
+    static constexpr int INF = 32000;
+    static constexpr int MATE = 31000;
+    static constexpr int MAX_PLY = 128;
+    static_assert(Evaluation::MAX_SCORE < MATE - MAX_PLY, "static scores must stay below mate scores");
+
+    explicit Search(TranspositionTable &tt);
+
+    // info boş değilse her tamamlanan derinlik için bir satır yazılır (düğüm sayısı tüm iş parçacıklarının toplamı)
+    SearchResult think(Board &board, const SearchLimits &limits, std::ostream *info = nullptr);
+
+    // Oyundan önceki konumların anahtarları (tekrar tespiti için)
+    void setHistory(const std::vector<std::uint64_t> &keys) { gameHistory = keys; }
+
+    // Tablodaki konumlar aranmadan kesin değerleriyle puanlanır
+    void setTablebase(std::shared_ptr<const Tablebase> tables) { tablebase = std::move(tables); }
+
+    // Tablo sonucunun ply derinliğindeki puanı; mesafe bilinmiyorsa mat puanlarının hemen altında
+    static int tablebaseScore(const Tablebase::Result &known, int ply);
+
+    static bool isMateScore(int score) { return score > MATE - MAX_PLY || score < -MATE + MAX_PLY; }
+
+private:
+    TranspositionTable &tt;
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point startTime;
+    std::uint64_t nodes = 0;
+    bool stopped = false;
+    Move rootBest;
+
+    // Ana aramada kendi bayrağını, yardımcılarda ana aramanınkini gösterir
+    std::atomic<bool> stopFlag{false};
+    std::atomic<bool> *stopSignal = &stopFlag;
+    std::atomic<std::uint64_t> publishedNodes{0};
+    int threadId = 0;
+    std::vector<std::unique_ptr<Search>> helpers;
+
+    std::vector<std::uint64_t> gameHistory;
+    std::shared_ptr<const Tablebase> tablebase;
+    std::vector<std::uint64_t> keyStack;
+
+    Move killers[MAX_PLY][2];
+    std::vector<int> historyScores;
+    bool hadRoyal[2] = {false, false};
+
+    void prepare(const Board &board);
+    SearchResult iterate(Board &board, Move firstMove, std::ostream *info);
+    std::uint64_t totalNodes() const;
+
+    int negamax(Board &board, const Evaluation &eval, int depth, int alpha, int beta, int ply);
+    int quiescence(Board &board, const Evaluation &eval, int alpha, int beta, int ply);
+
+    void scoreMoves(const Board &board, const Evaluation &eval, const MoveList &moves,
+                    std::uint32_t ttMove, int ply, int *scores) const;
+    // Sıralama puanları için yer: yığındaki tampon yetmezse spill büyütülür
+    static int *scoreStorage(const MoveList &moves, int *buffer, std::vector<int> &spill);
+    static void pickNext(MoveList &moves, int *scores, std::size_t index);
+
+    bool royalLost(const Board &board) const;
+    bool isRepetition(std::uint64_t key) const;
+    void checkLimits();
+    double elapsedSeconds() const;
+};
+
+#endif
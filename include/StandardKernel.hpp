@@ -0,0 +1,129 @@
+#ifndef STANDARD_KERNEL_HPP
+#define STANDARD_KERNEL_HPP
+
+#include "Bitboard.hpp"
+#include "ConfigReader.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 8x8 tabloları derleme zamanında üreten yardımcılar
+namespace standard_tables {
+
+constexpr int SIZE = 8;
+constexpr int SQUARES = SIZE * SIZE;
+
+constexpr std::uint64_t bit(int sq) { return std::uint64_t(1) << sq; }
+
+constexpr int KNIGHT_DX[8] = {1, 2, 2, 1, -1, -2, -2, -1};
+constexpr int KNIGHT_DY[8] = {2, 1, -1, -2, -2, -1, 1, 2};
+constexpr int PAWN_DX[2] = {1, -1};
+constexpr int WHITE_PAWN_DY[2] = {1, 1};
+constexpr int BLACK_PAWN_DY[2] = {-1, -1};
+
+template <std::size_t N>
+constexpr std::array<std::uint64_t, SQUARES> leaperTable(const int (&dx)[N], const int (&dy)[N]) {
+    std::array<std::uint64_t, SQUARES> table{};
+    for (int sq = 0; sq < SQUARES; ++sq) {
+        for (std::size_t i = 0; i < N; ++i) {
+            int x = sq % SIZE + dx[i];
+            int y = sq / SIZE + dy[i];
+            if (x >= 0 && x < SIZE && y >= 0 && y < SIZE) table[sq] |= bit(y * SIZE + x);
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<std::uint64_t, SQUARES>, DIRECTION_COUNT> rayTable() {
+    std::array<std::array<std::uint64_t, SQUARES>, DIRECTION_COUNT> table{};
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        for (int sq = 0; sq < SQUARES; ++sq) {
+            for (int x = sq % SIZE + DIRECTION_DX[d], y = sq / SIZE + DIRECTION_DY[d];
+                 x >= 0 && x < SIZE && y >= 0 && y < SIZE; x += DIRECTION_DX[d], y += DIRECTION_DY[d]) {
+                table[d][sq] |= bit(y * SIZE + x);
+            }
+        }
+    }
+    return table;
+}
+
+} // namespace standard_tables
+
+// Standart 8x8 taş takımı için derleme zamanında üretilmiş saldırı tabloları. Yüklenen taşlar
+// standart satranca birebir uyuyorsa Board bu yolu seçer; diğer her şey genel tablolarla çalışır.
+class StandardKernel {
+public:
+    enum Kind : int { KING, QUEEN, ROOK, BISHOP, KNIGHT, PAWN, KIND_COUNT, NONE = -1 };
+
+    static constexpr int SIZE = standard_tables::SIZE;
+    static constexpr int SQUARES = standard_tables::SQUARES;
+
+    // Taş tipinin standart karşılığı; uymuyorsa NONE
+    static Kind kindOf(const PieceConfig &piece);
+
+    // Tüm taşlar standart tiplerdense ve tahta 8x8 ise true
+    static bool matches(const std::vector<PieceConfig> &pieces, int boardSize);
+
+    static constexpr std::uint64_t bit(int sq) { return standard_tables::bit(sq); }
+
+    static constexpr auto KNIGHT_ATTACKS = standard_tables::leaperTable(standard_tables::KNIGHT_DX, standard_tables::KNIGHT_DY);
+    static constexpr auto KING_ATTACKS = standard_tables::leaperTable(DIRECTION_DX, DIRECTION_DY);
+    static constexpr std::array<std::array<std::uint64_t, SQUARES>, 2> PAWN_ATTACKS = {
+        standard_tables::leaperTable(standard_tables::PAWN_DX, standard_tables::WHITE_PAWN_DY),
+        standard_tables::leaperTable(standard_tables::PAWN_DX, standard_tables::BLACK_PAWN_DY)};
+    static constexpr auto RAYS = standard_tables::rayTable();
+
+    // Kare indeksinin arttığı yönler (N, E, NE, NW) ilk engeli en düşük bitte bulur
+    static constexpr bool isPositiveDirection(int dir) { return dir == 0 || dir == 2 || dir == 4 || dir == 5; }
+
+    static constexpr std::uint64_t slide(int sq, int dir, std::uint64_t occupied) {
+        std::uint64_t ray = RAYS[dir][sq];
+        std::uint64_t blockers = ray & occupied;
+        if (!blockers) return ray;
+        int first = isPositiveDirection(dir) ? std::countr_zero(blockers) : 63 - std::countl_zero(blockers);
+        return ray ^ RAYS[dir][first];
+    }
+
+    static constexpr std::uint64_t rookAttacks(int sq, std::uint64_t occupied) {
+        return slide(sq, 0, occupied) | slide(sq, 1, occupied) | slide(sq, 2, occupied) | slide(sq, 3, occupied);
+    }
+
+    static constexpr std::uint64_t bishopAttacks(int sq, std::uint64_t occupied) {
+        return slide(sq, 4, occupied) | slide(sq, 5, occupied) | slide(sq, 6, occupied) | slide(sq, 7, occupied);
+    }
+
+    // kind rengindeki taşın sq'dan alış yapabileceği kareler
+    static constexpr std::uint64_t attacksFrom(Kind kind, int color, int sq, std::uint64_t occupied) {
+        switch (kind) {
+        case KING: return KING_ATTACKS[sq];
+        case QUEEN: return rookAttacks(sq, occupied) | bishopAttacks(sq, occupied);
+        case ROOK: return rookAttacks(sq, occupied);
+        case BISHOP: return bishopAttacks(sq, occupied);
+        case KNIGHT: return KNIGHT_ATTACKS[sq];
+        case PAWN: return PAWN_ATTACKS[color][sq];
+        default: return 0;
+        }
+    }
+
+    // Tip indeksleri (PieceRegistry içinde) ile color renginden sq'yu alabilecek taşlar
+    static std::uint64_t attackersTo(const BitboardSet<1> &set, const std::array<int, KIND_COUNT> &types, int sq,
+                                     int color, std::uint64_t occupied) {
+        auto pieces = [&](Kind kind) {
+            return types[kind] < 0 ? std::uint64_t(0) : set.byType[color][types[kind]].words[0];
+        };
+        std::uint64_t queens = pieces(QUEEN);
+        return (KNIGHT_ATTACKS[sq] & pieces(KNIGHT)) | (KING_ATTACKS[sq] & pieces(KING)) |
+               (PAWN_ATTACKS[color ^ 1][sq] & pieces(PAWN)) |
+               (rookAttacks(sq, occupied) & (pieces(ROOK) | queens)) |
+               (bishopAttacks(sq, occupied) & (pieces(BISHOP) | queens));
+    }
+};
+
+static_assert(std::popcount(StandardKernel::KNIGHT_ATTACKS[0]) == 2);
+static_assert(std::popcount(StandardKernel::KING_ATTACKS[27]) == 8);
+static_assert(StandardKernel::rookAttacks(0, 0) == 0x01010101010101FEULL);
+
+#endif
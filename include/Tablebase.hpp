@@ -0,0 +1,123 @@
+#ifndef TABLEBASE_HPP
+#define TABLEBASE_HPP
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Az taşlı oyun sonlarının tam çözümü. Bir taş takımının (malzeme) tüm yerleşimleri, portal
+// bekleme durumları ve hamle sırası için sonuç (kazanç/beraberlik/kayıp) ve mata kalan yarım
+// hamle sayısı geriye doğru analizle hesaplanır. Her malzeme ayrı bir dosyadır: "CTBL" başlığı,
+// konum başına 2 bitlik sonuçlar ve isteğe bağlı olarak konum başına bir baytlık mesafe.
+// Okuyucu dosyaları belleğe eşler (mmap); sorgu bellek ayırmaz.
+//
+// Tablolar taşları oynamış sayar (rok yok); terfi ve geçerken alma bu motorda uygulanmadığından
+// konum yalnızca taşların yeri, portal beklemeleri ve hamle sırasıyla belirlenir. Tekrar ve
+// hamle sınırı hesaba katılmaz.
+class Tablebase {
+public:
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 64;
+    static constexpr int MAX_PIECES = 16;
+
+    // Hamle sırası gelen taraf açısından sonuç
+    enum class Wdl : std::int8_t { LOSS = -1, DRAW = 0, WIN = 1 };
+
+    struct Result {
+        Wdl wdl = Wdl::DRAW;
+        int dtm = -1;   // mata (ya da royal taşın alınmasına) kalan yarım hamle; bilinmiyorsa -1
+    };
+
+    struct BuildOptions {
+        int jobs = 1;
+        bool dtm = true;              // false ise yalnızca sonuçlar yazılır
+        std::size_t memoryMb = 2048;  // geriye doğru hamle listesi için üst sınır
+    };
+
+    struct BuildStats {
+        int tables = 0;               // bu çağrıda çözülen tablolar (alt malzemeler dahil)
+        int reused = 0;               // dizinde zaten bulunanlar
+        std::uint64_t positions = 0;
+        std::uint64_t wins = 0;
+        std::uint64_t draws = 0;
+        std::uint64_t losses = 0;
+        int maxDtm = 0;
+        int symmetries = 1;           // istenen malzemede kullanılan tahta simetrisi sayısı
+    };
+
+    // Malzeme: taş kodları (Board::makeCode), sıralı. Alma ile ulaşılan alt malzemeler önce çözülür;
+    // directory içinde aynı varyant için yazılmış olanlar yeniden kullanılır.
+    static bool build(const Board &start, std::uint64_t variantHash, std::vector<Board::PieceCode> material,
+                      const std::string &directory, const BuildOptions &options, BuildStats &stats,
+                      std::string &error);
+
+    // Malzemenin dosya adı, ör. "King+Rook_vs_King.ctb"
+    static std::string fileName(const Board &start, const std::vector<Board::PieceCode> &material);
+
+    Tablebase();
+    ~Tablebase();
+
+    Tablebase(const Tablebase &) = delete;
+    Tablebase &operator=(const Tablebase &) = delete;
+
+    // directory içindeki bu varyanta ait tüm tabloları aç; hiç tablo yoksa false
+    bool open(const std::string &directory, const Board &start, std::uint64_t variantHash);
+    void close();
+    const std::string &error() const { return lastError; }
+
+    std::size_t tableCount() const { return tables.size(); }
+    int maxPieces() const { return largest; }
+
+    // Konum yüklü bir tablodaysa sonucu yaz. Rok hakkı süren konumlar tabloda yoktur.
+    bool probe(const Board &board, Result &result) const;
+
+    // Tablonun önerdiği hamle: kazançta mata en kısa, kayıpta en uzun yol, berabere konumda
+    // beraberliği koruyan hamle. Konum ya da hamlelerinden biri tabloda yoksa boş hamle.
+    Move bestMove(Board &board, Result *result = nullptr) const;
+
+    class Layout;
+    struct Table;
+
+private:
+    std::vector<std::unique_ptr<Table>> tables;
+    int largest = 0;
+    std::string lastError;
+
+    const Table *findTable(const Board &board) const;
+};
+
+// Bir malzemenin konum numaralandırması. İlk taş simetri altında temsilci karelere indirgenir,
+// diğer taşlar tüm karelerde dolaşır; ardından portal bekleme durumları ve hamle sırası gelir.
+class Tablebase::Layout {
+public:
+    Layout(const Board &start, std::vector<Board::PieceCode> material);
+
+    const std::vector<Board::PieceCode> &material() const { return pieces; }
+    std::uint64_t size() const { return positions; }
+    int symmetries() const { return static_cast<int>(transforms.size()); }
+
+    // Tahtadaki konumun numarası; malzeme uymuyorsa ya da rok hakkı sürüyorsa false
+    bool index(const Board &board, std::uint64_t &out) const;
+
+    // index numaralı konumu board üzerine kur (önceki taşlar kaldırılır); iki taş aynı karedeyse false
+    bool setup(Board &board, std::uint64_t index) const;
+
+private:
+    int boardSize;
+    int squareCount;
+    std::vector<Board::PieceCode> pieces;
+    std::vector<int> cooldownRadix;          // portal başına (en uzun bekleme + 1)
+    std::vector<std::vector<int>> transforms;   // geçerli simetriler, kare -> kare
+    std::vector<int> domainIndex;            // temsilci kare -> sıra, diğerleri -1
+    std::vector<int> domainSquares;
+    std::vector<int> toDomain;               // kare -> onu temsilciye götüren simetri
+    std::uint64_t positions = 0;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef TRANSPOSITION_TABLE_HPP
+#define TRANSPOSITION_TABLE_HPP
+
+#include "Move.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+enum class Bound : std::uint8_t {
+    NONE = 0,
+    UPPER = 1,
+    LOWER = 2,
+    EXACT = 3
+};
+
+struct TTEntry {
+    std::uint64_t key = 0;
+    std::uint32_t move = 0;         // Move::compact()
+    std::int16_t score = 0;
+    std::int8_t depth = 0;
+    std::uint8_t boundAndAge = 0;   // [0..1] Bound, [2..7] nesil
+
+    Bound bound() const { return static_cast<Bound>(boundAndAge & 3); }
+    int age() const { return boundAndAge >> 2; }
+
+    // Anahtar dışındaki alanlar tek 64 bitlik kelimeye paketlenir
+    std::uint64_t pack() const {
+        return static_cast<std::uint64_t>(move) |
+               (static_cast<std::uint64_t>(static_cast<std::uint16_t>(score)) << 32) |
+               (static_cast<std::uint64_t>(static_cast<std::uint8_t>(depth)) << 48) |
+               (static_cast<std::uint64_t>(boundAndAge) << 56);
+    }
+
+    static TTEntry unpack(std::uint64_t key, std::uint64_t data) {
+        TTEntry entry;
+        entry.key = key;
+        entry.move = static_cast<std::uint32_t>(data);
+        entry.score = static_cast<std::int16_t>(static_cast<std::uint16_t>(data >> 32));
+        entry.depth = static_cast<std::int8_t>(static_cast<std::uint8_t>(data >> 48));
+        entry.boundAndAge = static_cast<std::uint8_t>(data >> 56);
+        return entry;
+    }
+};
+
+// Sabit bellekli, kova başına 4 girişli konum tablosu (bir kova = bir önbellek satırı).
+// Arama iş parçacıkları arasında kilitsiz paylaşılır: her giriş iki atomik kelimedir ve
+// anahtar kelimesi (key ^ data) olarak saklanır. Yarım yazılmış bir giriş okunduğunda
+// XOR doğrulaması tutmaz ve giriş yok sayılır.
+class TranspositionTable {
+public:
+    static constexpr int BUCKET_SIZE = 4;
+
+    explicit TranspositionTable(std::size_t sizeMb = 16);
+
+    // Tabloyu yeniden boyutlandır (sizeMb'ı aşmayan en büyük 2'nin kuvveti kova) ve temizle
+    void resize(std::size_t sizeMb);
+    void clear();
+
+    // Yeni arama başlarken eski girişlerin önce yer değiştirmesi için nesli ilerlet
+    void newSearch();
+
+    bool probe(std::uint64_t key, TTEntry &entry) const;
+    void store(std::uint64_t key, Move move, int score, int depth, Bound bound);
+
+    std::size_t bucketCount() const { return buckets; }
+    std::size_t sizeBytes() const { return buckets * sizeof(Bucket); }
+
+    // Örnek kovalarda bu nesle ait girişlerin binde oranı
+    int hashfull() const;
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> keyXorData{0};
+        std::atomic<std::uint64_t> data{0};
+
+        // Doğrulanmış giriş; başka bir iş parçacığı yazarken okunduysa boş döner
+        TTEntry load() const {
+            std::uint64_t d = data.load(std::memory_order_relaxed);
+            std::uint64_t k = keyXorData.load(std::memory_order_relaxed) ^ d;
+            return TTEntry::unpack(k, d);
+        }
+
+        void save(const TTEntry &entry) {
+            std::uint64_t d = entry.pack();
+            keyXorData.store(entry.key ^ d, std::memory_order_relaxed);
+            data.store(d, std::memory_order_relaxed);
+        }
+    };
+
+    struct alignas(64) Bucket {
+        Slot entries[BUCKET_SIZE];
+    };
+
+    std::unique_ptr<Bucket[]> table;
+    std::size_t buckets = 0;
+    std::atomic<std::uint8_t> generation{0};
+
+    // Kova sayısı 2'nin kuvveti
+    Bucket &bucketFor(std::uint64_t key) const {
+        return table[static_cast<std::size_t>(key) & (buckets - 1)];
+    }
+};
+
+#endif
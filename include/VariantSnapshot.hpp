@@ -0,0 +1,36 @@
+#ifndef VARIANT_SNAPSHOT_HPP
+#define VARIANT_SNAPSHOT_HPP
+
+#include "ConfigReader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Doğrulanmış bir varyantın ikili anlık görüntüsü. Başlık: "CVAR", sürüm, yük uzunluğu, yükün
+// FNV-1a özeti, kaynak JSON dosyasının boyutu ve değişme zamanı, varyant özeti
+// (ConfigReader::hashConfig). Yük: GameConfig alanları sırayla, ardından PieceRegistry sırasıyla
+// her taş tipinin beyaz ve siyah hareket tabloları. Okuyucu dosyayı belleğe eşler (mmap), özeti
+// denetler ve tabloları yeniden derlemeden kurar.
+class VariantSnapshot {
+public:
+    static constexpr std::uint16_t VERSION = 2;
+    static constexpr std::size_t HEADER_SIZE = 48;
+
+    // JSON yapılandırmasının yanındaki anlık görüntü: "data/x.json" -> "data/x.cvar"
+    static std::string pathFor(const std::string &configPath);
+
+    // Dosya anlık görüntü imzasıyla başlıyorsa true
+    static bool isSnapshot(const std::string &path);
+
+    // config'i derlenmiş tablolarıyla yaz. sourcePath boş değilse boyutu ve değişme zamanı
+    // başlığa girer; load aynı kaynakla çağrıldığında bunlar tutmazsa görüntü eski sayılır.
+    static bool write(const GameConfig &config, const std::string &path, const std::string &sourcePath,
+                      std::string &error);
+
+    // Anlık görüntüyü config içine çöz; config.compiled_registry derlenmiş tabloları taşır
+    static bool load(const std::string &path, const std::string &sourcePath, GameConfig &config,
+                     std::string &error);
+};
+
+#endif
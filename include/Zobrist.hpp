@@ -0,0 +1,37 @@
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+
+#include <cstdint>
+
+// Konum anahtarları tablo yerine karıştırma fonksiyonuyla üretilir: her tahta boyutu ve
+// taş tipi sayısı için bellek gerektirmez ve aynı varyantta süreçler arasında sabittir.
+class Zobrist {
+public:
+    static constexpr std::uint64_t mix(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // kind = taş tipi * 2 + renk
+    static constexpr std::uint64_t piece(int sq, int kind) {
+        return mix(PIECE_SEED ^ (static_cast<std::uint64_t>(sq) << 20) ^ static_cast<std::uint64_t>(kind));
+    }
+
+    // Portalın kalan bekleme süresi (remaining > 0)
+    static constexpr std::uint64_t cooldown(int portal, int remaining) {
+        return mix(COOLDOWN_SEED ^ (static_cast<std::uint64_t>(portal) << 32) ^ static_cast<std::uint64_t>(remaining));
+    }
+
+    static constexpr std::uint64_t sideToMove() {
+        return mix(SIDE_SEED);
+    }
+
+private:
+    static constexpr std::uint64_t PIECE_SEED = 0x5a6f62726973742dULL;
+    static constexpr std::uint64_t COOLDOWN_SEED = 0x636f6f6c646f776eULL;
+    static constexpr std::uint64_t SIDE_SEED = 0x736964652d746f2dULL;
+};
+
+#endif
@@ -1,24 +1,37 @@
-#include "board.hpp"
+#include "Board.hpp"
+#include "BoardRenderer.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <type_traits>
 
 Board::Board(int size) : board_size(size) {
-    board_map.clear();
-    portals.clear();
+    squares.assign(static_cast<size_t>(size) * size, EMPTY);
+    listIndex.assign(squares.size(), -1);
+    attackCount[WHITE].assign(squares.size(), 0);
+    attackCount[BLACK].assign(squares.size(), 0);
+    occupancy = OccupancyTiles(size);
 }
 
-void Board::initialize(const std::vector<PieceConfig> &pieces, const std::vector<PortalConfig> &portals) {
-    this->portals = portals;
+void Board::initialize(const std::vector<PieceConfig> &pieces, const std::vector<PortalConfig> &portals,
+                       std::shared_ptr<const PieceRegistry> compiled) {
+    this->portals = PortalSystem(portals, board_size);
+
+    registry = compiled ? std::move(compiled) : std::make_shared<const PieceRegistry>(pieces, board_size);
+    standardKernel = registry->usesStandardKernel();
+    resetBitboards();
+
     for (const auto &piece : pieces) {
+        int type = registry->find(piece.type);
+
         // Beyaz taşları yerleştir
         if (piece.positions.count("white") > 0) {
             for (const auto &pos : piece.positions.at("white")) {
                 if (isPositionValid(pos)) {
-                    std::string key = posToKey(pos.x, pos.y);
-                    auto copy = std::make_shared<PieceConfig>(piece);
-                    copy->isWhite = true; 
-                    board_map[key] = copy;
+                    placeCode(squareIndex(pos.x, pos.y), makeCode(type, WHITE));
                 } else {
                     std::cerr << "Invalid white position: (" << pos.x << ", " << pos.y << ")\n";
                 }
@@ -29,10 +42,7 @@ void Board::initialize(const std::vector<PieceConfig> &pieces, const std::vector
         if (piece.positions.count("black") > 0) {
             for (const auto &pos : piece.positions.at("black")) {
                 if (isPositionValid(pos)) {
-                    std::string key = posToKey(pos.x, pos.y);
-                    auto copy = std::make_shared<PieceConfig>(piece);
-                    copy->isWhite = false;  
-                    board_map[key] = copy;
+                    placeCode(squareIndex(pos.x, pos.y), makeCode(type, BLACK));
                 } else {
                     std::cerr << "Invalid black position: (" << pos.x << ", " << pos.y << ")\n";
                 }
@@ -41,14 +51,14 @@ void Board::initialize(const std::vector<PieceConfig> &pieces, const std::vector
     }
 }
 
+void Board::initialize(const GameConfig &config) {
+    std::vector<PieceConfig> allPieces = config.pieces;
+    allPieces.insert(allPieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+    initialize(allPieces, config.portals, config.compiled_registry);
+}
 
 Board Board::clone() const {
-    Board newBoard(board_size);
-    for (const auto &entry : board_map) {
-        newBoard.board_map[entry.first] = std::make_shared<PieceConfig>(*entry.second);
-    }
-    newBoard.portals = portals;
-    return newBoard;
+    return *this;
 }
 
 bool Board::isPositionValid(const Position &pos) const {
@@ -56,100 +66,184 @@ bool Board::isPositionValid(const Position &pos) const {
 }
 
 void Board::print() const {
-    // Sütun harflerini yaz
-    std::cout << "\033[33m   ";
-    for (char c = 'a'; c < 'a' + board_size; ++c) {
-        std::cout << c << " ";
-    }
-    std::cout << "\033[0m" << std::endl;
-
-    // Satırları yaz
-    for (int y = 0; y < board_size; ++y) {
-        std::cout << "\033[33m" << (board_size - y) << " ";
-        if (board_size - y < 10) std::cout << " ";
-        std::cout << "\033[0m";
-
-        for (int x = 0; x < board_size; ++x) {
-            std::string key = posToKey(x, y);
-            auto it = board_map.find(key);
-
-            if (it != board_map.end() && it->second) {
-                // Renk: beyaz için beyaz, siyah için mavi
-                std::cout << (it->second->isWhite ? "\033[37m" : "\033[34m");
-
-                // Taş simgesi
-                char symbol = (it->second->type == "Knight") ? 'N' : it->second->type[0];
-                std::cout << symbol << "\033[0m ";
-            } else {
-                std::cout << ". ";
-            }
-        }
-
-        std::cout << "\033[33m" << (board_size - y) << "\033[0m" << std::endl;
-    }
-
-    // Alt satırda tekrar sütun harflerini yaz
-    std::cout << "\033[33m   ";
-    for (char c = 'a'; c < 'a' + board_size; ++c) {
-        std::cout << c << " ";
-    }
-    std::cout << "\033[0m" << std::endl;
+    std::string buffer;
+    BoardRenderer::appendFrame(*this, buffer);
+    std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::cout.flush();
 }
 
-
-
 bool Board::movePiece(int x1, int y1, int x2, int y2) {
     handlePortal(x1, y1, x2, y2);
 
-    std::string fromKey = posToKey(x1, y1);
-    std::string toKey = posToKey(x2, y2);
-
-    auto itFrom = board_map.find(fromKey);
-    if (itFrom == board_map.end() || !itFrom->second) {
+    if (!isSquareValid(x1, y1) || squares[squareIndex(x1, y1)] == EMPTY) {
         std::cerr << "Error: No piece at source position (" << x1 << ", " << y1 << ")." << std::endl;
         return false;
     }
 
-    if (!isPositionValid({x2, y2})) {
+    if (!isSquareValid(x2, y2)) {
         std::cerr << "Error: Target position (" << x2 << ", " << y2 << ") is invalid." << std::endl;
         return false;
     }
 
-    board_map[toKey] = std::move(itFrom->second);
-    board_map.erase(itFrom);
+    relocateCode(squareIndex(x1, y1), squareIndex(x2, y2));
     return true;
 }
 
 bool Board::movePieceForCloneBoard(int x1, int y1, int x2, int y2) {
-    std::string fromKey = posToKey(x1, y1);
-    std::string toKey = posToKey(x2, y2);
-
-    auto itFrom = board_map.find(fromKey);
-    if (itFrom == board_map.end() || !itFrom->second) return false;
-    if (!isPositionValid({x2, y2})) return false;
+    if (!isSquareValid(x1, y1) || squares[squareIndex(x1, y1)] == EMPTY) return false;
+    if (!isSquareValid(x2, y2)) return false;
 
-    board_map[toKey] = std::move(itFrom->second);
-    board_map.erase(itFrom);
+    relocateCode(squareIndex(x1, y1), squareIndex(x2, y2));
     return true;
 }
 
+void Board::makeMove(Move move, UndoRecord &undo) {
+    int from = move.from();
+    int to = move.to();
+    PieceCode mover = squares[from];
+
+    undo.move = move;
+    undo.mover = mover;
+    undo.captured = squares[to];
+    undo.capturedAtExit = EMPTY;
+    undo.landing = to;
+    undo.previousCooldownUntil = 0;
+    undo.previousKey = zobristKey;
+
+    zobristKey ^= cooldownKey();
+    if (move.flags() & Move::PORTAL) {
+        // Yön koruyan portal: taş doğrudan devam ettiği kareye gider
+        undo.portal = continuationPortal(from, to);
+        relocateCode(from, to);
+        if (undo.portal >= 0) undo.previousCooldownUntil = portals.startCooldown(undo.portal, ply);
+    } else {
+        relocateCode(from, to);
+        undo.portal = findPortalHop(to, colorOf(mover));
+        if (undo.portal >= 0) {
+            int exit = portals.exitSquare(undo.portal);
+            undo.landing = exit;
+            undo.capturedAtExit = squares[exit];
+            relocateCode(to, exit);
+            undo.previousCooldownUntil = portals.startCooldown(undo.portal, ply);
+        }
+    }
+
+    ++ply;
+    portals.tick(ply);
+    whiteToMove = !whiteToMove;
+    zobristKey ^= cooldownKey() ^ Zobrist::sideToMove();
+}
+
+void Board::unmakeMove(const UndoRecord &undo) {
+    portals.untick(ply);
+    --ply;
+    whiteToMove = !whiteToMove;
+
+    int from = undo.move.from();
+    int to = undo.move.to();
+
+    if (undo.portal >= 0) {
+        portals.restoreCooldown(undo.portal, undo.previousCooldownUntil);
+    }
+    if (undo.landing != to) {
+        relocateCode(undo.landing, to);
+        if (undo.capturedAtExit != EMPTY) placeCode(undo.landing, undo.capturedAtExit);
+    }
+
+    relocateCode(to, from);
+    squares[from] = undo.mover;
+    if (undo.captured != EMPTY) placeCode(to, undo.captured);
+    zobristKey = undo.previousKey;
+}
+
+void Board::setPiece(int sq, PieceCode code) {
+    if (code == EMPTY) {
+        if (squares[sq] != EMPTY) removeCode(sq);
+        return;
+    }
+    placeCode(sq, code);
+}
+
+void Board::setSideToMove(bool white) {
+    if (whiteToMove != white) zobristKey ^= Zobrist::sideToMove();
+    whiteToMove = white;
+}
+
+void Board::setPortalCooldown(int portal, int remaining) {
+    zobristKey ^= cooldownKey();
+    portals.setCooldown(portal, ply + std::max(remaining, 0), ply);
+    zobristKey ^= cooldownKey();
+}
+
+std::uint64_t Board::pieceKey(int sq, PieceCode code) const {
+    return Zobrist::piece(sq, typeOf(code) * 2 + colorOf(code));
+}
+
+std::uint64_t Board::cooldownKey() const {
+    std::uint64_t result = 0;
+    for (int portal : portals.activeCooldowns()) {
+        int remaining = portals.cooldownEnd(portal) - ply;
+        if (remaining > 0) result ^= Zobrist::cooldown(portal, remaining);
+    }
+    return result;
+}
+
+std::uint64_t Board::computeKey() const {
+    std::uint64_t result = cooldownKey();
+    for (int color = 0; color < 2; ++color) {
+        for (int sq : pieceSquares[color]) {
+            result ^= pieceKey(sq, squares[sq]);
+        }
+    }
+    if (!whiteToMove) result ^= Zobrist::sideToMove();
+    return result;
+}
+
+int Board::findPortalHop(int sq, int color) const {
+    for (int i = portals.firstAtEntry(sq); i >= 0; i = portals.nextAtEntry(i)) {
+        if (!portals.isReady(i, ply) || !portals.allows(i, color)) continue;
+
+        // Çıkışta kendi taşı varsa geçiş yapılmaz
+        int exit = portals.exitSquare(i);
+        if (exit == sq || (squares[exit] != EMPTY && colorOf(squares[exit]) == color)) continue;
+
+        return i;
+    }
+    return -1;
+}
+
+int Board::continuationPortal(int from, int to) const {
+    int found = -1;
+    forEachPortalContinuation(from, [&](int portal, int target, std::uint32_t) {
+        if (target != to) return false;
+        found = portal;
+        return true;
+    });
+    return found;
+}
+
+Board::PieceCode Board::victimOf(Move move) const {
+    PieceCode code = squares[move.to()];
+    if (code != EMPTY || (move.flags() & Move::PORTAL)) return code;
+    int portal = findPortalHop(move.to(), colorOf(squares[move.from()]));
+    return portal >= 0 ? squares[portals.exitSquare(portal)] : EMPTY;
+}
+
 void Board::handlePortal(int x1, int y1, int &x2, int &y2) {
-    auto piece = getPiece(x1, y1);
-    if (!piece) return;
-
-    std::string color = piece->getIsWhite() ? "white" : "black";
-
-    for (const auto &portal : portals) {
-        if (portal.positions.entry.x == x1 && portal.positions.entry.y == y1) {
-            const auto &allowed = portal.properties.allowed_colors;
-            if (std::find(allowed.begin(), allowed.end(), color) != allowed.end()) {
-                x2 = portal.positions.exit.x;
-                y2 = portal.positions.exit.y;
-                std::cout << "Moved through portal: (" << x1 << ", " << y1 << ") -> (" << x2 << ", " << y2 << ")\n";
-                return;
-            } else {
-                std::cout << "Portal at (" << x1 << ", " << y1 << ") not allowed for " << color << " pieces.\n";
-            }
+    if (!isSquareValid(x1, y1)) return;
+    int sq = squareIndex(x1, y1);
+    PieceCode code = squares[sq];
+    if (code == EMPTY) return;
+
+    int color = colorOf(code);
+    for (int i = portals.firstAtEntry(sq); i >= 0; i = portals.nextAtEntry(i)) {
+        if (portals.allows(i, color)) {
+            x2 = squareX(portals.exitSquare(i));
+            y2 = squareY(portals.exitSquare(i));
+            std::cout << "Moved through portal: (" << x1 << ", " << y1 << ") -> (" << x2 << ", " << y2 << ")\n";
+            return;
+        } else {
+            std::cout << "Portal at (" << x1 << ", " << y1 << ") not allowed for " << (color == WHITE ? "white" : "black") << " pieces.\n";
         }
     }
 }
@@ -162,26 +256,209 @@ std::string Board::getKey(int x, int y) const {
     return posToKey(x, y);
 }
 
+bool Board::keyToSquare(const std::string &key, int &sq) const {
+    size_t comma = key.find(',');
+    if (comma == std::string::npos) return false;
+
+    int x = 0, y = 0;
+    try {
+        x = std::stoi(key.substr(0, comma));
+        y = std::stoi(key.substr(comma + 1));
+    } catch (const std::exception &) {
+        return false;
+    }
+
+    if (!isSquareValid(x, y)) return false;
+    sq = squareIndex(x, y);
+    return true;
+}
+
 bool Board::hasPieceAt(const std::string &key) const {
-    auto it = board_map.find(key);
-    return it != board_map.end() && it->second;
+    int sq;
+    return keyToSquare(key, sq) && squares[sq] != EMPTY;
+}
+
+const PieceType *Board::getPiece(const std::string &key) const {
+    int sq;
+    if (keyToSquare(key, sq)) {
+        return pieceAt(sq);
+    }
+    return nullptr;
+}
+
+void Board::placeCode(int sq, PieceCode code) {
+    if (squares[sq] != EMPTY) {
+        removeCode(sq);
+    }
+    auto &list = pieceSquares[colorOf(code)];
+    listIndex[sq] = static_cast<int>(list.size());
+    list.push_back(sq);
+    if (!standardKernel) updateSlidersThrough(sq, -1);
+    squares[sq] = code;
+    occupancy.set(sq);
+    if (!standardKernel) addAttacks(sq, code, +1);
+    moveRoyal(code, -1, sq);
+    bitboardAdd(sq, code);
+    zobristKey ^= pieceKey(sq, code);
+}
+
+void Board::removeCode(int sq) {
+    PieceCode code = squares[sq];
+    bitboardRemove(sq, code);
+    zobristKey ^= pieceKey(sq, code);
+    if (!standardKernel) addAttacks(sq, code, -1);
+    moveRoyal(code, sq, -1);
+    auto &list = pieceSquares[colorOf(code)];
+    int idx = listIndex[sq];
+    int last = list.back();
+    list[idx] = last;
+    listIndex[last] = idx;
+    list.pop_back();
+    listIndex[sq] = -1;
+    squares[sq] = EMPTY;
+    occupancy.reset(sq);
+    if (!standardKernel) updateSlidersThrough(sq, +1);
+}
+
+void Board::relocateCode(int from, int to) {
+    if (from == to) return;
+    if (squares[to] != EMPTY) {
+        removeCode(to);
+    }
+    // Yer değiştiren taş oynamış sayılır; bit anahtara ve bitboardlara girmez
+    PieceCode code = squares[from] | MOVED_BIT;
+    bitboardRemove(from, code);
+    bitboardAdd(to, code);
+    zobristKey ^= pieceKey(from, code) ^ pieceKey(to, code);
+    int idx = listIndex[from];
+    pieceSquares[colorOf(code)][idx] = to;
+    listIndex[to] = idx;
+    listIndex[from] = -1;
+
+    if (standardKernel) {
+        squares[to] = code;
+        squares[from] = EMPTY;
+        occupancy.reset(from);
+        occupancy.set(to);
+        moveRoyal(code, from, to);
+        return;
+    }
+
+    // Taş tahtadan kalkmış gibi saldırıları güncellenir, sonra hedefe konur
+    addAttacks(from, code, -1);
+    squares[from] = EMPTY;
+    occupancy.reset(from);
+    updateSlidersThrough(from, +1);
+    updateSlidersThrough(to, -1);
+    squares[to] = code;
+    occupancy.set(to);
+    addAttacks(to, code, +1);
+    moveRoyal(code, from, to);
 }
 
-const std::shared_ptr<PieceConfig>& Board::getPiece(const std::string &key) const {
-    auto it = board_map.find(key);
-    if (it != board_map.end()) {
-        return it->second;
+void Board::addAttacks(int sq, PieceCode code, int delta) {
+    const MovementTable &table = movementOf(code);
+    auto &counts = attackCount[colorOf(code)];
+
+    for (const int *target = table.leapsBegin(sq); target != table.leapsEnd(sq); ++target) {
+        counts[*target] += delta;
+    }
+
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        const auto &ray = table.ray(sq, d);
+        for (int i = 0; i < ray.captureLength; ++i) {
+            int target = table.target(ray, i);
+            counts[target] += delta;
+            if (squares[target] != EMPTY) break;
+        }
     }
-    static std::shared_ptr<PieceConfig> nullPiece = nullptr;
-    return nullPiece;
 }
 
-const std::shared_ptr<PieceConfig>& Board::getPiece(int x, int y) const {
-    std::string key = posToKey(x, y);
-    return getPiece(key);  
+void Board::updateSlidersThrough(int sq, int delta) {
+    // sq boşaldığında (delta = +1) ya da dolduğunda (delta = -1) içinden geçen kayan
+    // taşların ışınları sq'nun ötesinde ilk engele ya da menzil sonuna kadar uzar veya kısalır
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        int distance = 0;
+        int sliderSq = firstOccupied(sq, oppositeDirection(d), distance);
+        if (sliderSq < 0) continue;
+
+        PieceCode slider = squares[sliderSq];
+        const MovementTable &table = movementOf(slider);
+        const auto &ray = table.ray(sliderSq, d);
+        if (ray.captureLength <= distance) continue;
+
+        auto &counts = attackCount[colorOf(slider)];
+        for (int i = distance; i < ray.captureLength; ++i) {
+            int target = table.target(ray, i);
+            counts[target] += delta;
+            if (squares[target] != EMPTY) break;
+        }
+    }
 }
 
+void Board::moveRoyal(PieceCode code, int from, int to) {
+    if (!isRoyal(code)) return;
+    auto &royals = royalSquares[colorOf(code)];
+    if (from < 0) {
+        royals.push_back(to);
+        return;
+    }
+    auto it = std::find(royals.begin(), royals.end(), from);
+    if (to < 0) {
+        royals.erase(it);
+    } else {
+        *it = to;
+    }
+}
 
-void Board::handleCooldowns() {
-    // Placeholder 
+void Board::resetBitboards() {
+    int squareCount = board_size * board_size;
+    int typeCount = registry->size();
+    if (squareCount <= BitboardSet<1>::Mask::CAPACITY) {
+        bitboards.emplace<BitboardSet<1>>(board_size, typeCount);
+    } else if (squareCount <= BitboardSet<4>::Mask::CAPACITY) {
+        bitboards.emplace<BitboardSet<4>>(board_size, typeCount);
+    } else if (squareCount <= BitboardSet<16>::Mask::CAPACITY) {
+        bitboards.emplace<BitboardSet<16>>(board_size, typeCount);
+    } else {
+        bitboards.emplace<std::monostate>();
+    }
+}
+
+void Board::bitboardAdd(int sq, PieceCode code) {
+    std::visit([&](auto &set) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(set)>, std::monostate>) {
+            set.add(sq, colorOf(code), typeOf(code));
+        }
+    }, bitboards);
+}
+
+void Board::bitboardRemove(int sq, PieceCode code) {
+    std::visit([&](auto &set) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(set)>, std::monostate>) {
+            set.remove(sq, colorOf(code), typeOf(code));
+        }
+    }, bitboards);
+}
+
+bool Board::isPathClear(int from, int to, int ignoreSq) const {
+    return std::visit([&](const auto &set) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(set)>, std::monostate>) {
+            int dx = squareX(to) - squareX(from);
+            int dy = squareY(to) - squareY(from);
+            int dir = directionBetween(dx, dy);
+            if (dir < 0) return true;
+            // Boş karolar atlanır; ignoreSq'da durulursa aramaya oradan devam edilir
+            int remaining = std::max(std::abs(dx), std::abs(dy));
+            for (int sq = from;;) {
+                int distance = 0;
+                sq = firstOccupied(sq, dir, distance);
+                remaining -= distance;
+                if (sq < 0 || remaining <= 0) return true;
+                if (sq != ignoreSq) return false;
+            }
+        } else {
+            return set.pathClear(from, to, ignoreSq);
+        }
+    }, bitboards);
 }
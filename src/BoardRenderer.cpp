@@ -0,0 +1,224 @@
+#include "BoardRenderer.hpp"
+#include "Notation.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+
+// Tahta çizimi: üstte sütun harfleri (çok harfli sütunlarda harf başına bir satır), solda sıra
+// numaraları, her kare 2 karakter. 26x26'ya kadar kareler 2. satırdan ve 4. sütundan başlar.
+int fileRows(int boardSize) {
+    return static_cast<int>(Notation::fileToString(boardSize - 1).size());
+}
+
+int rankWidth(int boardSize) {
+    return std::max(3, static_cast<int>(std::to_string(boardSize).size()) + 1);
+}
+
+int firstRow(int boardSize) {
+    return fileRows(boardSize) + 1;
+}
+
+int firstColumn(int boardSize) {
+    return rankWidth(boardSize) + 1;
+}
+
+// Tahta çiziminin genişliği: sol sıra numaraları, kareler ve sağdaki sıra numarası
+int frameWidth(int boardSize) {
+    return rankWidth(boardSize) + 2 * boardSize + static_cast<int>(std::to_string(boardSize).size());
+}
+
+// Artımlı kipte tahtanın altında metin için kalması gereken en az satır
+constexpr int MIN_TEXT_ROWS = 3;
+
+// Standart çıktının terminal boyutu; sorgulanamazsa false
+bool terminalSize(int &rows, int &columns) {
+    winsize size{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0 || size.ws_col == 0) {
+        return false;
+    }
+    rows = size.ws_row;
+    columns = size.ws_col;
+    return true;
+}
+
+const char *const LABEL = "\033[33m";
+const char *const RESET = "\033[0m";
+
+void appendNumber(std::string &buffer, int value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+// Sütun adları sağa yaslı, alt alta: "ab" sütununun 'a'sı üst satırda, 'b'si alt satırda
+void appendFiles(std::string &buffer, int boardSize) {
+    int rows = fileRows(boardSize);
+    for (int row = 0; row < rows; ++row) {
+        buffer += LABEL;
+        buffer.append(rankWidth(boardSize), ' ');
+        for (int x = 0; x < boardSize; ++x) {
+            std::string file = Notation::fileToString(x);
+            int pad = rows - static_cast<int>(file.size());
+            buffer += row < pad ? ' ' : file[row - pad];
+            buffer += ' ';
+        }
+        buffer += RESET;
+        buffer += '\n';
+    }
+}
+
+void appendSquare(const Board &board, Board::PieceCode code, std::string &buffer) {
+    if (code == Board::EMPTY) {
+        buffer += ". ";
+        return;
+    }
+    // Renk: beyaz için beyaz, siyah için mavi
+    buffer += Board::isBlackCode(code) ? "\033[34m" : "\033[37m";
+    buffer += board.pieceType(code).symbol;
+    buffer += RESET;
+    buffer += ' ';
+}
+
+// CSI satır;sütun H
+void appendCursor(std::string &buffer, int row, int column) {
+    buffer += "\033[";
+    appendNumber(buffer, row);
+    buffer += ';';
+    appendNumber(buffer, column);
+    buffer += 'H';
+}
+
+Board::PieceCode visibleCode(Board::PieceCode code) {
+    return static_cast<Board::PieceCode>(code & ~Board::MOVED_BIT);
+}
+
+} // namespace
+
+BoardRenderer::BoardRenderer(std::ostream &out, bool incremental) : out(out), incremental(incremental) {}
+
+BoardRenderer::~BoardRenderer() {
+    // Kaydırma bölgesini tüm ekrana geri ver
+    if (pinned) {
+        out << "\033[r" << std::flush;
+    }
+}
+
+bool BoardRenderer::isTerminal() {
+    return isatty(STDOUT_FILENO) != 0;
+}
+
+void BoardRenderer::appendFrame(const Board &board, std::string &buffer) {
+    int n = board.board_size;
+    int width = rankWidth(n);
+    appendFiles(buffer, n);
+
+    for (int y = 0; y < n; ++y) {
+        int rank = n - y;
+        buffer += LABEL;
+        std::size_t start = buffer.size();
+        appendNumber(buffer, rank);
+        buffer.append(width - (buffer.size() - start), ' ');
+        buffer += RESET;
+
+        for (int x = 0; x < n; ++x) {
+            appendSquare(board, board.codeAt(board.squareIndex(x, y)), buffer);
+        }
+
+        buffer += LABEL;
+        appendNumber(buffer, rank);
+        buffer += RESET;
+        buffer += '\n';
+    }
+
+    appendFiles(buffer, n);
+}
+
+void BoardRenderer::render(const Board &board) {
+    buffer.clear();
+    if (!incremental) {
+        appendFrame(board, buffer);
+        flush();
+        return;
+    }
+
+    int n = board.board_size;
+    int rows = 0;
+    int columns = 0;
+    bool known = terminalSize(rows, columns);
+    bool resized = rows != terminalRows || columns != terminalColumns;
+    terminalRows = rows;
+    terminalColumns = columns;
+
+    if (!known || columns < frameWidth(n) || rows < firstRow(n) + n + fileRows(n) + MIN_TEXT_ROWS - 1) {
+        // Sığmayan satırlar kayar ve imleç adresleri yanlış karelere düşer: düz tam çizime dön
+        if (pinned) buffer += "\033[r";
+        pinned = false;
+        appendFrame(board, buffer);
+    } else if (!pinned || resized || n != size) {
+        renderFull(board);
+    } else {
+        renderChanges(board);
+    }
+    flush();
+}
+
+void BoardRenderer::renderFull(const Board &board) {
+    int n = board.board_size;
+    int textRow = firstRow(n) + n + fileRows(n);
+
+    // Kaydırma bölgesini kaldır, ekranı temizle, tahtayı çiz ve altını metin için ayır
+    buffer += "\033[r\033[H\033[2J";
+    appendFrame(board, buffer);
+    buffer += "\033[";
+    appendNumber(buffer, textRow);
+    buffer += 'r';
+    appendCursor(buffer, textRow, 1);
+
+    size = n;
+    pinned = true;
+    shown.assign(static_cast<std::size_t>(n) * n, Board::EMPTY);
+    shownSquares.clear();
+    board.occupancy.forEachOccupied([&](int sq) {
+        shown[sq] = visibleCode(board.codeAt(sq));
+        shownSquares.push_back(sq);
+    });
+}
+
+void BoardRenderer::renderChanges(const Board &board) {
+    // İmleci sakla, değişen kareleri yaz, imleci metin bölgesindeki yerine döndür
+    buffer += "\0337";
+    std::size_t header = buffer.size();
+    int row = firstRow(size);
+    int column = firstColumn(size);
+
+    // Yalnızca önceki çizimde dolu olan ve şimdi dolu olan kareler değişmiş olabilir
+    auto refresh = [&](int sq) {
+        Board::PieceCode code = visibleCode(board.codeAt(sq));
+        if (code == shown[sq]) return;
+        shown[sq] = code;
+        appendCursor(buffer, row + board.squareY(sq), column + 2 * board.squareX(sq));
+        appendSquare(board, code, buffer);
+    };
+    for (int sq : shownSquares) refresh(sq);
+    shownSquares.clear();
+    board.occupancy.forEachOccupied([&](int sq) {
+        refresh(sq);
+        shownSquares.push_back(sq);
+    });
+
+    if (buffer.size() == header) {
+        buffer.clear();
+        return;
+    }
+    buffer += "\0338";
+}
+
+void BoardRenderer::flush() {
+    if (buffer.empty()) return;
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+}
@@ -0,0 +1,75 @@
+#include "ComputerPlayer.hpp"
+#include "CommandLine.hpp"
+#include "Notation.hpp"
+
+#include <algorithm>
+
+ComputerPlayer::ComputerPlayer(const SearchLimits &limits, std::size_t hashMb)
+    : limits(limits), tt(hashMb), search(tt) {}
+
+Move ComputerPlayer::chooseMove(Board &board, const std::vector<std::uint64_t> &history, std::ostream *info) {
+    if (book) {
+        Move move = book->probe(board);
+        if (!move.isNone()) {
+            result = SearchResult();
+            result.bestMove = move;
+            if (info) *info << "info book " << Notation::moveToString(board, move) << "\n";
+            return move;
+        }
+    }
+
+    if (tablebase) {
+        Tablebase::Result known;
+        Move move = tablebase->bestMove(board, &known);
+        if (!move.isNone()) {
+            result = SearchResult();
+            result.bestMove = move;
+            result.score = Search::tablebaseScore(known, 0);
+            if (info) {
+                *info << "info tablebase " << Notation::moveToString(board, move);
+                if (known.wdl == Tablebase::Wdl::DRAW) {
+                    *info << " draw";
+                } else {
+                    *info << (known.wdl == Tablebase::Wdl::WIN ? " win" : " loss");
+                    if (known.dtm >= 0) *info << " dtm " << known.dtm;
+                }
+                *info << "\n";
+            }
+            return move;
+        }
+    }
+
+    search.setHistory(history);
+    result = search.think(board, limits, info);
+    return result.bestMove;
+}
+
+void ComputerPlayer::setTablebase(std::shared_ptr<const Tablebase> tables) {
+    tablebase = std::move(tables);
+    search.setTablebase(tablebase);
+}
+
+bool ComputerPlayer::parseOption(int argc, char *argv[], int &i, SearchLimits &limits, std::size_t &hashMb) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) return false;
+
+    // Değer sayı değilse seçenek tanınmamış sayılır; çağıran kullanım metnini basar
+    const char *value = argv[i + 1];
+    bool parsed;
+    if (arg == "--depth") {
+        parsed = parseNumber(value, limits.maxDepth);
+    } else if (arg == "--nodes") {
+        parsed = parseNumber(value, limits.maxNodes);
+    } else if (arg == "--movetime") {
+        parsed = parseNumber(value, limits.moveTimeMs);
+    } else if (arg == "--threads") {
+        parsed = parseNumber(value, limits.threads);
+        limits.threads = std::max(1, limits.threads);
+    } else if (arg == "--hash") {
+        parsed = parseNumber(value, hashMb);
+    } else {
+        return false;
+    }
+    if (parsed) ++i;
+    return parsed;
+}
@@ -1,50 +1,627 @@
 #include "ConfigReader.hpp"
+#include "VariantSnapshot.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+// FNV-1a over the canonical field order below
+class ConfigHasher {
+public:
+  void add(std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      hash = (hash ^ ((value >> (8 * i)) & 0xFF)) * 0x100000001B3ULL;
+    }
+  }
+
+  void add(const std::string &text) {
+    add(text.size());
+    for (unsigned char c : text) {
+      hash = (hash ^ c) * 0x100000001B3ULL;
+    }
+  }
+
+  void add(const Position &pos) {
+    add(static_cast<std::uint64_t>(pos.x));
+    add(static_cast<std::uint64_t>(pos.y));
+  }
+
+  void add(const PieceConfig &piece) {
+    add(piece.type);
+
+    const Movement &m = piece.movement;
+    for (int value : {m.forward, m.sideways, m.diagonal, static_cast<int>(m.l_shape),
+                      m.diagonal_capture, m.first_move_forward}) {
+      add(static_cast<std::uint64_t>(value));
+    }
+
+    const SpecialAbilities &a = piece.special_abilities;
+    for (bool value : {a.castling, a.royal, a.jump_over, a.promotion, a.en_passant}) {
+      add(static_cast<std::uint64_t>(value));
+    }
+
+    // Unordered maps are hashed in key order
+    std::vector<std::string> keys;
+    for (const auto &[key, value] : a.custom_abilities) {
+      if (value) keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    add(keys.size());
+    for (const auto &key : keys) add(key);
+
+    for (const char *color : {"white", "black"}) {
+      auto it = piece.positions.find(color);
+      std::size_t count = it == piece.positions.end() ? 0 : it->second.size();
+      add(count);
+      for (std::size_t i = 0; i < count; ++i) add(it->second[i]);
+    }
+  }
+
+  std::uint64_t value() const { return hash; }
+
+private:
+  std::uint64_t hash = 0xCBF29CE484222325ULL;
+};
+
+// Line and column (1-based) of the last non-whitespace character the JSON
+// lexer consumed, i.e. the end of the token just reported to the handler
+struct TextPosition {
+  std::size_t line = 1;
+  std::size_t column = 0;
+  std::size_t cursorLine = 1;
+  std::size_t cursorColumn = 0;
+
+  std::string describe() const {
+    return "at line " + std::to_string(line) + ", column " +
+           std::to_string(column);
+  }
+};
+
+// Input iterator that updates a TextPosition as the lexer consumes characters,
+// so semantic errors can be reported where they occur. The lexer copies the
+// iterator, hence the position lives outside it.
+template <typename Base> class CountingIterator {
+public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = char;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const char *;
+  using reference = char;
+
+  CountingIterator(Base base, TextPosition *position)
+      : base(base), position(position) {}
+
+  char operator*() const { return *base; }
+
+  CountingIterator &operator++() {
+    char c = *base;
+    if (c == '\n') {
+      ++position->cursorLine;
+      position->cursorColumn = 0;
+    } else {
+      ++position->cursorColumn;
+      if (c != ' ' && c != '\t' && c != '\r') {
+        position->line = position->cursorLine;
+        position->column = position->cursorColumn;
+      }
+    }
+    ++base;
+    return *this;
+  }
+
+  bool operator==(const CountingIterator &other) const {
+    return base == other.base;
+  }
+  bool operator!=(const CountingIterator &other) const {
+    return !(*this == other);
+  }
+
+private:
+  Base base;
+  TextPosition *position;
+};
+
+// SAX handler that fills a GameConfig as tokens arrive. Only the sections
+// currently open are kept on a stack, so memory stays proportional to the
+// resulting config. Defaults and type rules match the former DOM parser:
+// unknown keys are skipped, sections of the wrong container type are ignored
+// where the DOM code ignored them, and mistyped values are errors.
+class ConfigSaxHandler {
+public:
+  using json = nlohmann::json;
+
+  ConfigSaxHandler(GameConfig &config, const TextPosition &position)
+      : config(config), position(position) {
+    config = GameConfig();
+    config.game_settings.name = "Custom Chess";
+    config.game_settings.board_size = 8;
+    config.game_settings.turn_limit = 100;
+  }
+
+  const std::string &error() const { return message; }
+
+  bool null() { return onValue(Value{Value::NUL}); }
+
+  bool boolean(bool value) {
+    Value v{Value::BOOLEAN};
+    v.boolean = value;
+    return onValue(v);
+  }
+
+  bool number_integer(json::number_integer_t value) {
+    Value v{Value::NUMBER};
+    v.number = value;
+    return onValue(v);
+  }
+
+  bool number_unsigned(json::number_unsigned_t value) {
+    return number_integer(static_cast<json::number_integer_t>(value));
+  }
+
+  bool number_float(json::number_float_t value, const std::string &) {
+    // Integer fields truncate like json::get<int>
+    return number_integer(static_cast<json::number_integer_t>(value));
+  }
+
+  bool string(std::string &value) {
+    Value v{Value::STRING};
+    v.text = &value;
+    return onValue(v);
+  }
+
+  bool binary(json::binary_t &) { return onValue(Value{Value::NUL}); }
+
+  bool start_object(std::size_t) {
+    if (!onValue(Value{Value::OBJECT})) return false;
+    stack.push_back({next, ""});
+    return true;
+  }
+
+  bool key(std::string &name) {
+    stack.back().key = std::move(name);
+    return true;
+  }
+
+  bool end_object() {
+    Frame frame = std::move(stack.back());
+    stack.pop_back();
+
+    // Portals with a properties object but no allowed_colors admit both
+    if (frame.section == PROPERTIES && !colorsGiven) {
+      config.portals.back().properties.allowed_colors = {"white", "black"};
+    }
+    return true;
+  }
+
+  bool start_array(std::size_t) {
+    if (!onValue(Value{Value::ARRAY})) return false;
+    stack.push_back({next, ""});
+    return true;
+  }
+
+  bool end_array() {
+    stack.pop_back();
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string &,
+                   const nlohmann::detail::exception &ex) {
+    message = ex.what();
+    return false;
+  }
+
+private:
+  enum Section {
+    ROOT,
+    SETTINGS,
+    PIECE_LIST,
+    PIECE,
+    POSITIONS,
+    POSITION_LIST,
+    POSITION,
+    MOVEMENT,
+    ABILITIES,
+    PORTAL_LIST,
+    PORTAL,
+    PORTAL_POSITIONS,
+    PORTAL_POINT,
+    PROPERTIES,
+    COLOR_LIST,
+    SKIP
+  };
+
+  struct Frame {
+    Section section;
+    std::string key; // last key read (objects only)
+  };
+
+  struct Value {
+    enum Kind { NUL, BOOLEAN, NUMBER, STRING, OBJECT, ARRAY } kind;
+    bool boolean = false;
+    json::number_integer_t number = 0;
+    std::string *text = nullptr;
+
+    bool isContainer() const { return kind == OBJECT || kind == ARRAY; }
+  };
+
+  GameConfig &config;
+  const TextPosition &position;
+  std::vector<Frame> stack;
+  Section next = SKIP; // section pushed by the container being opened
+  std::string message;
+
+  std::vector<PieceConfig> *pieceList = nullptr;
+  std::string positionColor;
+  Position *point = nullptr;
+  bool colorsGiven = false;
+
+  bool fail(const std::string &text) {
+    message = text + " " + position.describe();
+    return false;
+  }
+
+  bool expectInt(const Value &value, const std::string &key, int &out) {
+    if (value.kind != Value::NUMBER) {
+      return fail("\"" + key + "\" must be a number");
+    }
+    out = static_cast<int>(value.number);
+    return true;
+  }
+
+  bool expectBool(const Value &value, const std::string &key, bool &out) {
+    if (value.kind != Value::BOOLEAN) {
+      return fail("\"" + key + "\" must be true or false");
+    }
+    out = value.boolean;
+    return true;
+  }
+
+  bool expectString(const Value &value, const std::string &key,
+                    std::string &out) {
+    if (value.kind != Value::STRING) {
+      return fail("\"" + key + "\" must be a string");
+    }
+    out = std::move(*value.text);
+    return true;
+  }
+
+  // Open a section of the expected container type; any other value is
+  // skipped (ignore) or rejected
+  bool open(const Value &value, Value::Kind kind, Section section,
+            const std::string &key, bool ignore) {
+    if (value.kind == kind) {
+      next = section;
+      return true;
+    }
+    next = SKIP;
+    if (ignore) return true;
+    return fail("\"" + key + "\" must be " +
+                (kind == Value::OBJECT ? "an object" : "an array"));
+  }
+
+  bool skip(const Value &) {
+    next = SKIP;
+    return true;
+  }
+
+  bool onValue(const Value &value) {
+    if (stack.empty()) {
+      // Anything but an object at the top leaves every default in place
+      next = value.kind == Value::OBJECT ? ROOT : SKIP;
+      return true;
+    }
+
+    Frame &frame = stack.back();
+    const std::string &key = frame.key;
+
+    switch (frame.section) {
+    case ROOT:
+      if (key == "game_settings") {
+        return open(value, Value::OBJECT, SETTINGS, key, false);
+      }
+      if (key == "pieces" || key == "custom_pieces") {
+        pieceList = key == "pieces" ? &config.pieces : &config.custom_pieces;
+        if (value.kind == Value::ARRAY) pieceList->clear();
+        return open(value, Value::ARRAY, PIECE_LIST, key, true);
+      }
+      if (key == "portals") {
+        if (value.kind == Value::ARRAY) config.portals.clear();
+        return open(value, Value::ARRAY, PORTAL_LIST, key, true);
+      }
+      return skip(value);
+
+    case SETTINGS:
+      if (key == "name") {
+        return expectString(value, key, config.game_settings.name);
+      }
+      if (key == "board_size") {
+        return expectInt(value, key, config.game_settings.board_size);
+      }
+      if (key == "turn_limit") {
+        return expectInt(value, key, config.game_settings.turn_limit);
+      }
+      return skip(value);
+
+    case PIECE_LIST:
+      pieceList->emplace_back();
+      return open(value, Value::OBJECT, PIECE, "piece", false);
+
+    case PIECE: {
+      PieceConfig &piece = pieceList->back();
+      if (key == "type") return expectString(value, key, piece.type);
+      if (key == "count") return expectInt(value, key, piece.count);
+      if (key == "positions") {
+        return open(value, Value::OBJECT, POSITIONS, key, true);
+      }
+      if (key == "movement") {
+        return open(value, Value::OBJECT, MOVEMENT, key, false);
+      }
+      if (key == "special_abilities") {
+        return open(value, Value::OBJECT, ABILITIES, key, true);
+      }
+      return skip(value);
+    }
+
+    case POSITIONS:
+      if (key == "white" || key == "black") {
+        positionColor = key;
+        // Like the DOM parser, a color key exists only once it has positions
+        if (value.kind == Value::ARRAY) {
+          pieceList->back().positions.erase(key);
+        }
+        return open(value, Value::ARRAY, POSITION_LIST, key, true);
+      }
+      return skip(value);
+
+    case POSITION_LIST: {
+      auto &positions = pieceList->back().positions[positionColor];
+      positions.emplace_back();
+      point = &positions.back();
+      return open(value, Value::OBJECT, POSITION, "position", false);
+    }
+
+    case POSITION:
+    case PORTAL_POINT:
+      if (key == "x") return expectInt(value, key, point->x);
+      if (key == "y") return expectInt(value, key, point->y);
+      return skip(value);
+
+    case MOVEMENT: {
+      Movement &movement = pieceList->back().movement;
+      if (key == "forward") return expectInt(value, key, movement.forward);
+      if (key == "sideways") return expectInt(value, key, movement.sideways);
+      if (key == "diagonal") return expectInt(value, key, movement.diagonal);
+      if (key == "l_shape") return expectBool(value, key, movement.l_shape);
+      if (key == "diagonal_capture") {
+        return expectInt(value, key, movement.diagonal_capture);
+      }
+      if (key == "first_move_forward") {
+        return expectInt(value, key, movement.first_move_forward);
+      }
+      return skip(value);
+    }
+
+    case ABILITIES: {
+      SpecialAbilities &abilities = pieceList->back().special_abilities;
+      if (key == "castling") return expectBool(value, key, abilities.castling);
+      if (key == "royal") return expectBool(value, key, abilities.royal);
+      if (key == "jump_over") {
+        return expectBool(value, key, abilities.jump_over);
+      }
+      if (key == "promotion") {
+        return expectBool(value, key, abilities.promotion);
+      }
+      if (key == "en_passant") {
+        return expectBool(value, key, abilities.en_passant);
+      }
+      // Any other boolean is a custom ability; other values are ignored
+      if (value.kind == Value::BOOLEAN) {
+        abilities.custom_abilities[key] = value.boolean;
+      }
+      return skip(value);
+    }
+
+    case PORTAL_LIST: {
+      PortalConfig portal;
+      portal.type = "Portal";
+      config.portals.push_back(std::move(portal));
+      return open(value, Value::OBJECT, PORTAL, "portal", false);
+    }
+
+    case PORTAL: {
+      PortalConfig &portal = config.portals.back();
+      if (key == "type") return expectString(value, key, portal.type);
+      if (key == "id") return expectString(value, key, portal.id);
+      if (key == "positions") {
+        return open(value, Value::OBJECT, PORTAL_POSITIONS, key, true);
+      }
+      if (key == "properties") {
+        colorsGiven = false;
+        return open(value, Value::OBJECT, PROPERTIES, key, false);
+      }
+      return skip(value);
+    }
+
+    case PORTAL_POSITIONS:
+      if (key == "entry" || key == "exit") {
+        auto &positions = config.portals.back().positions;
+        point = key == "entry" ? &positions.entry : &positions.exit;
+        return open(value, Value::OBJECT, PORTAL_POINT, key, false);
+      }
+      return skip(value);
+
+    case PROPERTIES: {
+      PortalProperties &properties = config.portals.back().properties;
+      if (key == "preserve_direction") {
+        return expectBool(value, key, properties.preserve_direction);
+      }
+      if (key == "cooldown") return expectInt(value, key, properties.cooldown);
+      if (key == "allowed_colors" && value.kind == Value::ARRAY) {
+        colorsGiven = true;
+        properties.allowed_colors.clear();
+      }
+      if (key == "allowed_colors") {
+        return open(value, Value::ARRAY, COLOR_LIST, key, true);
+      }
+      return skip(value);
+    }
+
+    case COLOR_LIST: {
+      std::string color;
+      if (!expectString(value, "allowed_colors", color)) return false;
+      config.portals.back().properties.allowed_colors.push_back(
+          std::move(color));
+      return true;
+    }
+
+    case SKIP:
+      return skip(value);
+    }
+    return skip(value);
+  }
+};
+
+// Stream [first, last) through the SAX handler into config
+template <typename Iterator>
+bool parseConfig(Iterator first, Iterator last, bool strict,
+                 GameConfig &config, std::string &error) {
+  TextPosition position;
+  ConfigSaxHandler handler(config, position);
+  bool ok = nlohmann::json::sax_parse(
+      CountingIterator<Iterator>(first, &position),
+      CountingIterator<Iterator>(last, &position), &handler,
+      nlohmann::json::input_format_t::json, strict);
+  if (!ok) error = handler.error();
+  return ok;
+}
+
+} // namespace
 
 ConfigReader::ConfigReader() {}
 
 bool ConfigReader::loadFromFile(const std::string &filePath) {
-  try {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-      std::cerr << "Failed to open config file: " << filePath << std::endl;
+  if (filePath == STANDARD_VARIANT) {
+    return loadStandard();
+  }
+
+  std::string error;
+  if (VariantSnapshot::isSnapshot(filePath)) {
+    if (!VariantSnapshot::load(filePath, "", m_config, error)) {
+      std::cerr << "Failed to load variant snapshot: " << error << std::endl;
       return false;
     }
+    return validateConfig();
+  }
 
-    nlohmann::json jsonData;
-    file >> jsonData;
+  // A snapshot compiled from this exact file skips JSON parsing entirely
+  std::string snapshotPath = VariantSnapshot::pathFor(filePath);
+  if (VariantSnapshot::isSnapshot(snapshotPath)) {
+    if (VariantSnapshot::load(snapshotPath, filePath, m_config, error)) {
+      return validateConfig();
+    }
+    std::cerr << "Ignoring variant snapshot: " << error << std::endl;
+  }
 
-    parseGameSettings(jsonData);
-    parsePieces(jsonData);
-    parseCustomPieces(jsonData);
-    parsePortals(jsonData);
+  return loadFromJsonFile(filePath);
+}
 
-    return validateConfig();
-  } catch (const std::exception &e) {
-    std::cerr << "Error parsing config file: " << e.what() << std::endl;
+bool ConfigReader::loadFromJsonFile(const std::string &filePath) {
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Failed to open config file: " << filePath << std::endl;
+    return false;
+  }
+
+  // Files may carry trailing text after the config object, as with the
+  // former stream extraction
+  std::string error;
+  if (!parseConfig(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>(), false, m_config, error)) {
+    std::cerr << "Error parsing config file " << filePath << ": " << error
+              << std::endl;
     return false;
   }
+  return validateConfig();
 }
 
 bool ConfigReader::loadFromString(const std::string &jsonString) {
-  try {
-    nlohmann::json jsonData = nlohmann::json::parse(jsonString);
-
-    parseGameSettings(jsonData);
-    parsePieces(jsonData);
-    parseCustomPieces(jsonData);
-    parsePortals(jsonData);
-
-    return validateConfig();
-  } catch (const std::exception &e) {
-    std::cerr << "Error parsing config string: " << e.what() << std::endl;
+  std::string error;
+  if (!parseConfig(jsonString.data(), jsonString.data() + jsonString.size(),
+                   true, m_config, error)) {
+    std::cerr << "Error parsing config string: " << error << std::endl;
     return false;
   }
+  return validateConfig();
+}
+
+bool ConfigReader::loadStandard() {
+  m_config = GameConfig();
+  m_config.game_settings.name = "Standard Chess";
+  m_config.game_settings.board_size = 8;
+  m_config.game_settings.turn_limit = 100;
+
+  // Back rank files per piece, pawns fill the second rank
+  struct StandardPiece {
+    const char *type;
+    std::vector<int> files;
+    Movement movement;
+    SpecialAbilities abilities;
+  };
+  const StandardPiece pieces[] = {
+      {"King", {4}, {1, 1, 1, false, 0, 0}, {true, true, false, false, false, {}}},
+      {"Queen", {3}, {8, 8, 8, false, 0, 0}, {}},
+      {"Bishop", {2, 5}, {0, 0, 8, false, 0, 0}, {}},
+      {"Knight", {1, 6}, {0, 0, 0, true, 0, 0}, {false, false, true, false, false, {}}},
+      {"Rook", {0, 7}, {8, 8, 0, false, 0, 0}, {true, false, false, false, false, {}}},
+      {"Pawn", {0, 1, 2, 3, 4, 5, 6, 7}, {1, 0, 0, false, 1, 2}, {false, false, false, true, true, {}}},
+  };
+
+  for (const auto &standard : pieces) {
+    PieceConfig piece;
+    piece.type = standard.type;
+    piece.count = static_cast<int>(standard.files.size());
+    piece.movement = standard.movement;
+    piece.special_abilities = standard.abilities;
+
+    bool pawn = piece.type == "Pawn";
+    for (int file : standard.files) {
+      piece.positions["white"].push_back({file, pawn ? 1 : 0});
+      piece.positions["black"].push_back({file, pawn ? 6 : 7});
+    }
+    m_config.pieces.push_back(std::move(piece));
+  }
+
+  return validateConfig();
 }
 
 const GameConfig &ConfigReader::getConfig() const { return m_config; }
 
+std::uint64_t ConfigReader::hashConfig(const GameConfig &config) {
+  ConfigHasher hasher;
+  hasher.add(static_cast<std::uint64_t>(config.game_settings.board_size));
+  hasher.add(static_cast<std::uint64_t>(config.game_settings.turn_limit));
+
+  for (const auto *pieces : {&config.pieces, &config.custom_pieces}) {
+    hasher.add(pieces->size());
+    for (const auto &piece : *pieces) hasher.add(piece);
+  }
+
+  hasher.add(config.portals.size());
+  for (const auto &portal : config.portals) {
+    hasher.add(portal.positions.entry);
+    hasher.add(portal.positions.exit);
+    hasher.add(static_cast<std::uint64_t>(portal.properties.preserve_direction));
+    hasher.add(static_cast<std::uint64_t>(portal.properties.cooldown));
+    hasher.add(portal.properties.allowed_colors.size());
+    for (const auto &color : portal.properties.allowed_colors) hasher.add(color);
+  }
+  return hasher.value();
+}
+
 bool ConfigReader::validateConfig() {
   // Basic validation
   if (m_config.game_settings.name.empty()) {
@@ -52,7 +629,8 @@ bool ConfigReader::validateConfig() {
     return false;
   }
 
-  if (m_config.game_settings.board_size <= 0) {
+  if (m_config.game_settings.board_size <= 0 ||
+      m_config.game_settings.board_size > MAX_BOARD_SIZE) {
     std::cerr << "Invalid board size" << std::endl;
     return false;
   }
@@ -119,211 +697,3 @@ bool ConfigReader::validateConfig() {
 
   return true;
 }
-
-void ConfigReader::parseGameSettings(const nlohmann::json &json) {
-  if (json.contains("game_settings")) {
-    const auto &settings = json["game_settings"];
-
-    m_config.game_settings.name = settings.value("name", "Custom Chess");
-    m_config.game_settings.board_size = settings.value("board_size", 8);
-    m_config.game_settings.turn_limit = settings.value("turn_limit", 100);
-  } else {
-
-    m_config.game_settings.name = "Custom Chess";
-    m_config.game_settings.board_size = 8;
-    m_config.game_settings.turn_limit = 100;
-  }
-}
-
-void ConfigReader::parseSpecialAbilities(const nlohmann::json &abilities,
-                                         SpecialAbilities &specialAbilities) {
-  if (abilities.is_object()) {
-    // Parse standard abilities
-    specialAbilities.castling = abilities.value("castling", false);
-    specialAbilities.royal = abilities.value("royal", false);
-    specialAbilities.jump_over = abilities.value("jump_over", false);
-    specialAbilities.promotion = abilities.value("promotion", false);
-    specialAbilities.en_passant = abilities.value("en_passant", false);
-
-    for (auto it = abilities.begin(); it != abilities.end(); ++it) {
-      const std::string &key = it.key();
-
-      if (key != "castling" && key != "royal" && key != "jump_over" &&
-          key != "promotion" && key != "en_passant") {
-
-        if (it.value().is_boolean()) {
-          specialAbilities.custom_abilities[key] = it.value().get<bool>();
-        }
-      }
-    }
-  }
-}
-
-void ConfigReader::parsePieces(const nlohmann::json &json) {
-  if (!json.contains("pieces") || !json["pieces"].is_array()) {
-    return;
-  }
-
-  for (const auto &pieceJson : json["pieces"]) {
-    PieceConfig piece;
-
-    piece.type = pieceJson.value("type", "");
-    piece.count = pieceJson.value("count", 0);
-
-    if (pieceJson.contains("positions")) {
-      const auto &positions = pieceJson["positions"];
-
-      if (positions.contains("white") && positions["white"].is_array()) {
-        for (const auto &posJson : positions["white"]) {
-          Position pos;
-          pos.x = posJson.value("x", 0);
-          pos.y = posJson.value("y", 0);
-          piece.positions["white"].push_back(pos);
-        }
-      }
-
-      if (positions.contains("black") && positions["black"].is_array()) {
-        for (const auto &posJson : positions["black"]) {
-          Position pos;
-          pos.x = posJson.value("x", 0);
-          pos.y = posJson.value("y", 0);
-          piece.positions["black"].push_back(pos);
-        }
-      }
-    }
-
-    if (pieceJson.contains("movement")) {
-      const auto &movement = pieceJson["movement"];
-
-
-      piece.movement.forward = movement.value("forward", 0);
-      piece.movement.sideways = movement.value("sideways", 0);
-      piece.movement.diagonal = movement.value("diagonal", 0);
-      piece.movement.l_shape = movement.value("l_shape", false);
-      piece.movement.diagonal_capture = movement.value("diagonal_capture", 0);
-      piece.movement.first_move_forward =
-          movement.value("first_move_forward", 0);
-    }
-
-    if (pieceJson.contains("special_abilities")) {
-      parseSpecialAbilities(pieceJson["special_abilities"],
-                            piece.special_abilities);
-    }
-
-    m_config.pieces.push_back(piece);
-  }
-}
-
-void ConfigReader::parseCustomPieces(const nlohmann::json &json) {
-  if (!json.contains("custom_pieces") || !json["custom_pieces"].is_array()) {
-    return;
-  }
-
-  for (const auto &pieceJson : json["custom_pieces"]) {
-    PieceConfig piece;
-
-    // Parse basic properties
-    piece.type = pieceJson.value("type", "");
-    piece.count = pieceJson.value("count", 0);
-
-    // Parse positions
-    if (pieceJson.contains("positions")) {
-      const auto &positions = pieceJson["positions"];
-
-      // Parse white piece positions
-      if (positions.contains("white") && positions["white"].is_array()) {
-        for (const auto &posJson : positions["white"]) {
-          Position pos;
-          pos.x = posJson.value("x", 0);
-          pos.y = posJson.value("y", 0);
-          piece.positions["white"].push_back(pos);
-        }
-      }
-
-      // Parse black piece positions
-      if (positions.contains("black") && positions["black"].is_array()) {
-        for (const auto &posJson : positions["black"]) {
-          Position pos;
-          pos.x = posJson.value("x", 0);
-          pos.y = posJson.value("y", 0);
-          piece.positions["black"].push_back(pos);
-        }
-      }
-    }
-
-    // Parse movement
-    if (pieceJson.contains("movement")) {
-      const auto &movement = pieceJson["movement"];
-
-      // Set all movement properties with default 0 if not specified
-      piece.movement.forward = movement.value("forward", 0);
-      piece.movement.sideways = movement.value("sideways", 0);
-      piece.movement.diagonal = movement.value("diagonal", 0);
-      piece.movement.l_shape = movement.value("l_shape", false);
-      piece.movement.diagonal_capture = movement.value("diagonal_capture", 0);
-      piece.movement.first_move_forward =
-          movement.value("first_move_forward", 0);
-    }
-
-    // Parse special abilities
-    if (pieceJson.contains("special_abilities")) {
-      parseSpecialAbilities(pieceJson["special_abilities"],
-                            piece.special_abilities);
-    }
-
-    m_config.custom_pieces.push_back(piece);
-  }
-}
-
-void ConfigReader::parsePortals(const nlohmann::json &json) {
-  if (!json.contains("portals") || !json["portals"].is_array()) {
-    return;
-  }
-
-  for (const auto &portalJson : json["portals"]) {
-    PortalConfig portal;
-
-    // Parse basic properties
-    portal.type = portalJson.value("type", "Portal");
-    portal.id = portalJson.value("id", "");
-
-    // Parse positions
-    if (portalJson.contains("positions")) {
-      const auto &positions = portalJson["positions"];
-
-      // Parse entry position
-      if (positions.contains("entry")) {
-        portal.positions.entry.x = positions["entry"].value("x", 0);
-        portal.positions.entry.y = positions["entry"].value("y", 0);
-      }
-
-      // Parse exit position
-      if (positions.contains("exit")) {
-        portal.positions.exit.x = positions["exit"].value("x", 0);
-        portal.positions.exit.y = positions["exit"].value("y", 0);
-      }
-    }
-
-    // Parse properties
-    if (portalJson.contains("properties")) {
-      const auto &properties = portalJson["properties"];
-
-      portal.properties.preserve_direction =
-          properties.value("preserve_direction", true);
-      portal.properties.cooldown = properties.value("cooldown", 0);
-
-      // Parse allowed colors
-      if (properties.contains("allowed_colors") &&
-          properties["allowed_colors"].is_array()) {
-        for (const auto &color : properties["allowed_colors"]) {
-          portal.properties.allowed_colors.push_back(color);
-        }
-      } else {
-        // Default to allowing both colors if not specified
-        portal.properties.allowed_colors = {"white", "black"};
-      }
-    }
-
-    m_config.portals.push_back(portal);
-  }
-}
@@ -0,0 +1,60 @@
+#include "Evaluation.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+Evaluation::Evaluation(const Board &board) {
+    const PieceRegistry &registry = *board.registry;
+    values.assign(registry.size(), 0);
+    pawnLike.assign(registry.size(), 0);
+    for (int type = 0; type < registry.size(); ++type) {
+        values[type] = movementValue(registry.type(type), board.board_size);
+        pawnLike[type] = registry.type(type).has(PieceRegistry::PAWN_MOVES);
+    }
+
+    // Merkeze yakın karelere küçük bir bonus
+    int n = board.board_size;
+    centerBonus.assign(static_cast<size_t>(n) * n, 0);
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            int dx = std::abs(2 * x - (n - 1));
+            int dy = std::abs(2 * y - (n - 1));
+            centerBonus[board.squareIndex(x, y)] = std::max(0, 2 * (n - 1) - dx - dy) * 8 / std::max(1, n - 1);
+        }
+    }
+}
+
+int Evaluation::movementValue(const PieceType &type, int boardSize) {
+    if (type.has(PieceRegistry::ROYAL)) return 0;
+    if (type.has(PieceRegistry::PAWN_MOVES)) return PAWN_VALUE;
+
+    const auto &rules = type.movement;
+    auto reach = [boardSize](int range) { return std::min({range, boardSize - 1, MAX_REACH}); };
+
+    int value = 50;
+    if (rules.l_shape) value += 300;
+    if (rules.forward > 0) value += 2 * reach(rules.forward) * 18;
+    if (rules.sideways > 0) value += 2 * reach(rules.sideways) * 18;
+    if (rules.diagonal > 0) value += 4 * reach(rules.diagonal) * 12;
+    return value;
+}
+
+int Evaluation::evaluate(const Board &board) const {
+    int score[2] = {0, 0};
+    int n = board.board_size;
+
+    for (int color = 0; color < 2; ++color) {
+        for (int sq : board.pieceSquares[color]) {
+            int type = board.typeOf(board.codeAt(sq));
+            score[color] += values[type] + centerBonus[sq];
+            if (pawnLike[type]) {
+                // İlerleyen piyonlar biraz daha değerli
+                int advanced = color == Board::WHITE ? board.squareY(sq) : n - 1 - board.squareY(sq);
+                score[color] += advanced * 4;
+            }
+        }
+    }
+
+    int white = std::clamp(score[Board::WHITE] - score[Board::BLACK], -MAX_SCORE, MAX_SCORE);
+    return board.whiteToMove ? white : -white;
+}
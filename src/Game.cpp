@@ -1,8 +1,7 @@
 #include "Game.hpp"
 #include "Board.hpp"
 #include "Rules.hpp"
-#include "MoveValidator.hpp"  
-#include "PieceHelper.hpp"
+#include "Notation.hpp"
 
 
 #include <iostream>
@@ -10,8 +9,31 @@
 #include <sstream>
 
 Game::Game(const GameConfig& config)
-    : board(config.game_settings.board_size), config(config), isWhiteTurn(true), turnCount(0) {
-    board.initialize(config.pieces, config.portals);
+    : board(config.game_settings.board_size), validator(board), renderer(std::cout, BoardRenderer::isTerminal()),
+      config(config), isWhiteTurn(true), turnCount(0) {
+    board.initialize(config);
+    validator.rebuild();
+}
+
+void Game::setComputerPlayer(bool isWhite, const SearchLimits& limits, std::size_t hashMb) {
+    auto& computer = computers[isWhite ? Board::WHITE : Board::BLACK];
+    computer = std::make_unique<ComputerPlayer>(limits, hashMb);
+    computer->setBook(book);
+    computer->setTablebase(tablebase);
+}
+
+void Game::setOpeningBook(std::shared_ptr<const OpeningBook> openingBook) {
+    book = std::move(openingBook);
+    for (auto& computer : computers) {
+        if (computer) computer->setBook(book);
+    }
+}
+
+void Game::setTablebase(std::shared_ptr<const Tablebase> tables) {
+    tablebase = std::move(tables);
+    for (auto& computer : computers) {
+        if (computer) computer->setTablebase(tablebase);
+    }
 }
 
 void Game::start() {
@@ -21,7 +43,16 @@ void Game::start() {
 
     std::string input;
     while (turnCount < config.game_settings.turn_limit) {
-        board.print();
+        renderer.render(board);
+
+        if (computers[isWhiteTurn ? Board::WHITE : Board::BLACK]) {
+            if (!playComputerMove() || checkEndGame()) {
+                announceEnd();
+                break;
+            }
+            continue;
+        }
+
         std::cout << (isWhiteTurn ? "White's turn: " : "Black's turn: ");
 
         std::getline(std::cin, input);
@@ -36,97 +67,124 @@ void Game::start() {
         }
 
         if (checkEndGame()) {
-            std::cout << (isWhiteTurn ? "Black" : "White") << " wins!" << std::endl;
+            announceEnd();
             break;
         }
     }
 
     if (turnCount >= config.game_settings.turn_limit) {
+        result = GameResult::DRAW;
         std::cout << "Turn limit reached! Game is a draw." << std::endl;
     }
 }
 
+void Game::announceEnd() {
+    if (Rules::isCheck(board, isWhiteTurn)) {
+        result = isWhiteTurn ? GameResult::BLACK_WINS : GameResult::WHITE_WINS;
+        std::cout << (isWhiteTurn ? "Black" : "White") << " wins!" << std::endl;
+    } else {
+        result = GameResult::DRAW;
+        std::cout << "Stalemate! Game is a draw." << std::endl;
+    }
+}
+
 bool Game::processMove(const std::string& input) {
     int x1, y1, x2, y2;
-    if (!parseInput(input, x1, y1, x2, y2)) {
+    bool viaPortal;
+    if (!parseInput(input, x1, y1, x2, y2, viaPortal)) {
         std::cerr << "Invalid input format. Use format like e2e4." << std::endl;
         return false;
     }
 
-    std::string fromKey = board.getKey(x1, y1);
-    std::string toKey = board.getKey(x2, y2);
-
-    if (!board.hasPieceAt(fromKey)) {
+    Rules::MoveError reason;
+    Move move = Rules::findLegalMove(board, board.squareIndex(x1, y1), board.squareIndex(x2, y2), viaPortal, &reason);
+    switch (reason) {
+    case Rules::MoveError::NONE:
+        break;
+    case Rules::MoveError::NO_PIECE:
         std::cerr << "No piece at the source position." << std::endl;
         return false;
-    }
-
-    const auto& piece = board.getPiece(fromKey);
-
-    if (PieceHelper::isWhiteAt(*piece, {x1, y1}) != isWhiteTurn) {
+    case Rules::MoveError::WRONG_SIDE:
         std::cerr << "It's not your turn." << std::endl;
         return false;
-    }
-
-    if (!Rules::isValidMove(board, x1, y1, x2, y2)) {
+    case Rules::MoveError::NOT_A_MOVE:
         std::cerr << "Invalid move for this piece." << std::endl;
         return false;
+    case Rules::MoveError::LEAVES_ROYAL_IN_CHECK:
+        std::cerr << "Move leaves your king in check." << std::endl;
+        return false;
     }
 
 
-    MoveValidator validator(board);
     if (!validator.isPathValid({x1, y1}, {x2, y2})) {
         std::cerr << "Path is blocked. Move not allowed.\n";
         return false;
     }
 
-    board.handlePortal(x1, y1, x2, y2);
-
-    std::unique_ptr<PieceConfig> captured = nullptr;
-    if (board.hasPieceAt(toKey)) {
-        captured = std::make_unique<PieceConfig>(*board.getPiece(toKey));
-    }
+    applyMove(move);
+    std::cout << "Move successful: (" << x1 << ", " << y1 << ") -> (" << x2 << ", " << y2 << ")\n";
+    return true;
+}
 
-    if (!board.movePiece(x1, y1, x2, y2)) {
-        std::cerr << "Move failed." << std::endl;
+bool Game::playComputerMove() {
+    auto& computer = computers[isWhiteTurn ? Board::WHITE : Board::BLACK];
+    Move move = computer->chooseMove(board, positionKeys, &std::cout);
+    if (move.isNone()) {
         return false;
     }
 
-    recordMove(x1, y1, x2, y2, std::move(captured));
-    handleCooldowns();
-
-    isWhiteTurn = !isWhiteTurn;
-    turnCount++;
-    std::cout << "Move successful: (" << x1 << ", " << y1 << ") -> (" << x2 << ", " << y2 << ")\n";
+    std::cout << (isWhiteTurn ? "White" : "Black") << " (computer) plays "
+              << Notation::moveToString(board, move) << std::endl;
+    applyMove(move);
     return true;
 }
 
-bool Game::parseInput(const std::string& input, int& x1, int& y1, int& x2, int& y2) const {
-    if (input.length() != 4) return false;
+void Game::applyMove(Move move) {
+    Board::PieceCode captured = board.victimOf(move);
+
+    // Portal geçişi ve bekleme süreleri makeMove içinde işlenir
+    positionKeys.push_back(board.key());
+    Board::UndoRecord undo;
+    board.makeMove(move, undo);
+    validator.update(undo.move.from());
+    validator.update(undo.move.to());
+    validator.update(undo.landing);
 
-    char x1Char = input[0];
-    char y1Char = input[1];
-    char x2Char = input[2];
-    char y2Char = input[3];
+    recordMove(move, captured);
 
-    x1 = x1Char - 'a';
-    y1 = config.game_settings.board_size - (y1Char - '0');
-    x2 = x2Char - 'a';
-    y2 = config.game_settings.board_size - (y2Char - '0');
+    isWhiteTurn = !isWhiteTurn;
+    turnCount++;
+}
 
-    return board.isPositionValid({x1, y1}) && board.isPositionValid({x2, y2});
+bool Game::parseInput(const std::string& input, int& x1, int& y1, int& x2, int& y2, bool& viaPortal) const {
+    return Notation::parseMove(input, config.game_settings.board_size, x1, y1, x2, y2, &viaPortal);
 }
 
-bool Game::checkEndGame() const {
-    return Rules::isCheckmate(board, !isWhiteTurn);
+bool Game::checkEndGame() {
+    // Tablodaki konumlarda mat hamle üretmeden bilinir; zorunlu mat duyurulur
+    Tablebase::Result known;
+    if (tablebase && tablebase->probe(board, known) && known.wdl != Tablebase::Wdl::DRAW) {
+        if (known.dtm == 0) return true;
+        if (known.dtm > 0) {
+            bool whiteWins = (known.wdl == Tablebase::Wdl::WIN) == isWhiteTurn;
+            std::cout << "Tablebase: " << (whiteWins ? "White" : "Black") << " mates in " << (known.dtm + 1) / 2 << std::endl;
+        }
+        return false;
+    }
+
+    // Hamle sırası gelen tarafın yasal hamlesi yoksa oyun biter (mat ya da pat)
+    return !Rules::hasAnyLegalMove(board, isWhiteTurn);
 }
 
-void Game::recordMove(int x1, int y1, int x2, int y2, std::unique_ptr<PieceConfig> captured) {
-    moveHistory.push({x1, y1, x2, y2, std::move(captured)});
+void Game::recordMove(Move move, Board::PieceCode captured) {
+    moveHistory.push_back({move, captured});
 }
 
-void Game::handleCooldowns() {
-    if (!cooldownQueue.empty()) {
-        cooldownQueue.pop();
+bool Game::saveRecord(const std::string& path) const {
+    GameRecordWriter writer(path, ConfigReader::hashConfig(config), config.game_settings.board_size);
+    for (const auto& record : moveHistory) {
+        writer.addMove(record.move);
     }
+    writer.endGame(result);
+    return writer.close();
 }
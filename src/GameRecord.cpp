@@ -0,0 +1,243 @@
+#include "GameRecord.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[4] = {'C', 'G', 'R', 'C'};
+
+void putVarint(std::vector<std::uint8_t> &out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool getVarint(const std::uint8_t *&data, const std::uint8_t *end, std::uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7) {
+        std::uint8_t byte = *data++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// Başlık alanları küçük uçlu (little-endian) yazılır
+void putFixed(std::uint8_t *out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+std::uint64_t getFixed(const std::uint8_t *data, int bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+void encodeHeader(std::uint8_t *header, std::uint64_t variantHash, int boardSize, std::uint64_t games) {
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    putFixed(header + 4, GameRecord::VERSION, 2);
+    putFixed(header + 6, static_cast<std::uint64_t>(boardSize), 2);
+    putFixed(header + 8, variantHash, 8);
+    putFixed(header + 16, games, 8);
+}
+
+} // namespace
+
+bool GameRecord::MoveCursor::next(RecordedMove &move) {
+    std::uint64_t packed;
+    if (data >= end || !getVarint(data, end, packed)) return false;
+
+    std::uint64_t squares = packed >> 1;
+    std::uint64_t count = static_cast<std::uint64_t>(squareCount);
+    if (squares >= count * count) return false;
+
+    move.from = static_cast<int>(squares / count);
+    move.to = static_cast<int>(squares % count);
+    move.viaPortal = (packed & 1) != 0;
+    return true;
+}
+
+GameRecordWriter::GameRecordWriter(const std::string &path, std::uint64_t variantHash, int boardSize)
+    : out(path, std::ios::binary | std::ios::trunc), squareCount(boardSize * boardSize) {
+    std::uint8_t header[GameRecord::HEADER_SIZE];
+    encodeHeader(header, variantHash, boardSize, 0);
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+}
+
+GameRecordWriter::~GameRecordWriter() {
+    close();
+}
+
+void GameRecordWriter::addMove(int from, int to, bool viaPortal) {
+    std::uint64_t squares = static_cast<std::uint64_t>(from) * squareCount + to;
+    putVarint(moves, (squares << 1) | (viaPortal ? 1 : 0));
+    ++plies;
+}
+
+void GameRecordWriter::endGame(GameResult result) {
+    prefix.clear();
+    putVarint(prefix, plies);
+    prefix.push_back(static_cast<std::uint8_t>(result));
+    putVarint(prefix, moves.size());
+
+    out.write(reinterpret_cast<const char *>(prefix.data()), static_cast<std::streamsize>(prefix.size()));
+    out.write(reinterpret_cast<const char *>(moves.data()), static_cast<std::streamsize>(moves.size()));
+
+    moves.clear();
+    plies = 0;
+    ++games;
+}
+
+bool GameRecordWriter::close() {
+    if (!out.is_open()) return true;
+
+    // Oyun sayısı başlıktaki yerine yazılır
+    std::uint8_t count[8];
+    putFixed(count, games, 8);
+    out.seekp(16);
+    out.write(reinterpret_cast<const char *>(count), sizeof(count));
+
+    bool ok = out.good();
+    out.close();
+    return ok;
+}
+
+GameRecordReader::~GameRecordReader() {
+    close();
+}
+
+bool GameRecordReader::isRecordFile(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    in.read(magic, sizeof(magic));
+    return in.gcount() == static_cast<std::streamsize>(sizeof(MAGIC)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept : bytes(other.bytes), length(other.length) {
+    other.bytes = nullptr;
+    other.length = 0;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        unmap();
+        bytes = other.bytes;
+        length = other.length;
+        other.bytes = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+bool MappedFile::map(const std::string &path, std::size_t minSize, const std::string &what, std::string &error) {
+    unmap();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < minSize) {
+        ::close(fd);
+        error = path + " is not " + what;
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        error = "cannot map " + path;
+        return false;
+    }
+    bytes = static_cast<const std::uint8_t *>(mapped);
+    length = size;
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (bytes) {
+        munmap(const_cast<std::uint8_t *>(bytes), length);
+    }
+    bytes = nullptr;
+    length = 0;
+}
+
+void MappedFile::adviseSequential() const {
+    if (bytes) {
+        madvise(const_cast<std::uint8_t *>(bytes), length, MADV_SEQUENTIAL);
+    }
+}
+
+bool GameRecordReader::open(const std::string &path) {
+    close();
+
+    if (!file.map(path, GameRecord::HEADER_SIZE, "a game record", lastError)) return false;
+    file.adviseSequential();
+
+    const std::uint8_t *data = file.data();
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || getFixed(data + 4, 2) != GameRecord::VERSION) {
+        close();
+        lastError = path + " is not a version " + std::to_string(GameRecord::VERSION) + " game record";
+        return false;
+    }
+
+    size = static_cast<int>(getFixed(data + 6, 2));
+    hash = getFixed(data + 8, 8);
+    games = getFixed(data + 16, 8);
+    rewind();
+    lastError.clear();
+    return true;
+}
+
+void GameRecordReader::close() {
+    file.unmap();
+    position = 0;
+    index = 0;
+}
+
+bool GameRecordReader::next(GameRecord::GameView &game) {
+    if (!file.isMapped() || position >= file.size()) return false;
+
+    const std::uint8_t *cursor = file.data() + position;
+    const std::uint8_t *end = file.data() + file.size();
+    std::uint64_t plies;
+    std::uint64_t bytes;
+    if (!getVarint(cursor, end, plies) || cursor >= end) {
+        lastError = "truncated game header at offset " + std::to_string(position);
+        return false;
+    }
+    std::uint8_t result = *cursor++;
+    if (!getVarint(cursor, end, bytes) || bytes > static_cast<std::uint64_t>(end - cursor) || result > 3) {
+        lastError = "corrupt game at offset " + std::to_string(position);
+        return false;
+    }
+
+    game.index = index++;
+    game.result = static_cast<GameResult>(result);
+    game.plies = static_cast<std::uint32_t>(plies);
+    game.moves = cursor;
+    game.movesEnd = cursor + bytes;
+    game.squareCount = size * size;
+    position = static_cast<std::size_t>(game.movesEnd - file.data());
+    return true;
+}
+
+bool GameRecordReader::seek(std::size_t offset, std::uint64_t gameIndex) {
+    if (!file.isMapped() || offset < GameRecord::HEADER_SIZE || offset > file.size()) return false;
+    position = offset;
+    index = gameIndex;
+    return true;
+}
@@ -1,65 +1,196 @@
 #include "MoveValidator.hpp"
-#include <cmath>
+#include <algorithm>
+#include <utility>
+
+// Komşular saat yönünde sıralı: çift indeksler dik, tek indeksler çapraz komşular
+static constexpr int RING_DX[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+static constexpr int RING_DY[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
 
 MoveValidator::MoveValidator(const Board& board) : board(board) {
-    buildGraph();
+    squareCount = board.board_size * board.board_size;
+    rebuild();
 }
 
-std::string MoveValidator::posToKey(const Position& pos) const {
-    return std::to_string(pos.x) + "," + std::to_string(pos.y);
+std::array<int, 8> MoveValidator::ring(int sq) const {
+    std::array<int, 8> result;
+    int x = board.squareX(sq), y = board.squareY(sq);
+    for (int i = 0; i < 8; ++i) {
+        int nx = x + RING_DX[i], ny = y + RING_DY[i];
+        result[i] = board.isSquareValid(nx, ny) ? board.squareIndex(nx, ny) : NO_NEIGHBOR;
+    }
+    return result;
 }
 
-void MoveValidator::buildGraph() {
+void MoveValidator::rebuild() {
+    size_t words = (static_cast<size_t>(squareCount) + 63) / 64;
+    empty.assign(words, 0);
+    visited.assign(words, 0);
+    parent.clear();
+    rank.clear();
+    node.assign(squareCount, -1);
+
+    // Karolar sırayla işlenir; bir kare boş işaretlendiğinde yalnızca önceden işlenmiş
+    // boş komşularıyla birleşir
+    const OccupancyTiles& tiles = board.occupancy;
     int size = board.board_size;
-    for (int y = 0; y < size; ++y) {
-        for (int x = 0; x < size; ++x) {
-            Position current = {x, y};
-            std::string key = posToKey(current);
-            std::vector<Position> neighbors;
-
-            // Komşuları ekle
-            for (int dy = -1; dy <= 1; ++dy) {
-                for (int dx = -1; dx <= 1; ++dx) {
-                    if (dx == 0 && dy == 0) continue;
-                    Position neighbor = {x + dx, y + dy};
-                    if (board.isPositionValid(neighbor) &&
-                        (!board.hasPieceAt(board.getKey(neighbor.x, neighbor.y)) || neighbor.x == x && neighbor.y == y)) {
-                        neighbors.push_back(neighbor);
-                    }
+    for (int tile = 0; tile < tiles.tileCount(); ++tile) {
+        int x0 = (tile % tiles.tilesPerSide()) * OccupancyTiles::TILE_SIZE;
+        int y0 = (tile / tiles.tilesPerSide()) * OccupancyTiles::TILE_SIZE;
+        int x1 = std::min(x0 + OccupancyTiles::TILE_SIZE, size);
+        int y1 = std::min(y0 + OccupancyTiles::TILE_SIZE, size);
+
+        if (tiles.mask(tile) == 0) {
+            // Taşsız karo kendi içinde bağlıdır: tek düğüm, diğer karolara kenarından bağlanır
+            int n = newNode();
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    int sq = board.squareIndex(x, y);
+                    setEmpty(sq, true);
+                    node[sq] = n;
                 }
             }
+            for (int y = y0; y < y1; ++y) {
+                bool edgeRow = y == y0 || y == y1 - 1;
+                for (int x = x0; x < x1; ++x) {
+                    if (edgeRow || x == x0 || x == x1 - 1) uniteEmptyNeighbors(board.squareIndex(x, y), n);
+                }
+            }
+            continue;
+        }
 
-            adjacencyList[key] = neighbors;
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                int sq = board.squareIndex(x, y);
+                if (board.codeAt(sq) != Board::EMPTY) continue;
+                setEmpty(sq, true);
+                node[sq] = newNode();
+                uniteEmptyNeighbors(sq, node[sq]);
+            }
         }
     }
 }
 
-bool MoveValidator::isPathValid(const Position& from, const Position& to) {
-    return bfs(from, to);
+void MoveValidator::uniteEmptyNeighbors(int sq, int n) {
+    for (int neighbor : ring(sq)) {
+        if (neighbor != NO_NEIGHBOR && isEmpty(neighbor)) unite(n, node[neighbor]);
+    }
 }
 
-bool MoveValidator::bfs(const Position& start, const Position& target) {
-    std::queue<Position> q;
-    std::unordered_map<std::string, bool> visited;
+void MoveValidator::setEmpty(int sq, bool value) {
+    std::uint64_t bit = std::uint64_t(1) << (sq & 63);
+    if (value) empty[sq >> 6] |= bit;
+    else empty[sq >> 6] &= ~bit;
+}
 
-    q.push(start);
-    visited[posToKey(start)] = true;
+int MoveValidator::newNode() {
+    parent.push_back(static_cast<int>(parent.size()));
+    rank.push_back(0);
+    return parent.back();
+}
 
-    while (!q.empty()) {
-        Position current = q.front();
-        q.pop();
+int MoveValidator::find(int n) {
+    while (parent[n] != n) {
+        parent[n] = parent[parent[n]];
+        n = parent[n];
+    }
+    return n;
+}
 
-        if (current.x == target.x && current.y == target.y)
-            return true;
+void MoveValidator::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return;
+    if (rank[a] < rank[b]) std::swap(a, b);
+    parent[b] = a;
+    if (rank[a] == rank[b]) ++rank[a];
+}
 
-        for (const auto& neighbor : adjacencyList[posToKey(current)]) {
-            std::string key = posToKey(neighbor);
-            if (!visited[key]) {
-                visited[key] = true;
-                q.push(neighbor);
-            }
+void MoveValidator::update(int sq) {
+    bool nowEmpty = board.codeAt(sq) == Board::EMPTY;
+    if (nowEmpty == isEmpty(sq)) return;
+
+    if (nowEmpty) vacate(sq);
+    else occupy(sq);
+
+    // Bırakılan düğümler birikince baştan kur
+    if (parent.size() > static_cast<size_t>(4 * squareCount + 64)) rebuild();
+}
+
+void MoveValidator::vacate(int sq) {
+    setEmpty(sq, true);
+    node[sq] = newNode();
+    uniteEmptyNeighbors(sq, node[sq]);
+}
+
+void MoveValidator::occupy(int sq) {
+    setEmpty(sq, false);
+    node[sq] = -1;
+
+    // Komşu halkadaki boş kareleri yerel gruplara ayır: ardışık kareler ve iki dik komşu
+    // birbirine değer. Tek grup varsa sq'dan geçen her yol halkadan dolaşılabilir.
+    const std::array<int, 8> around = ring(sq);
+    int group[8];
+    for (int i = 0; i < 8; ++i) group[i] = i;
+    auto link = [&](int a, int b) {
+        if (around[a] == NO_NEIGHBOR || around[b] == NO_NEIGHBOR || !isEmpty(around[a]) || !isEmpty(around[b])) return;
+        int from = group[b], to = group[a];
+        for (int &g : group) {
+            if (g == from) g = to;
         }
+    };
+    for (int i = 0; i < 8; ++i) {
+        link(i, (i + 1) % 8);
+        if (i % 2 == 0) link(i, (i + 2) % 8);
     }
 
+    int representative[8];
+    int distinct = 0;
+    for (int i = 0; i < 8; ++i) {
+        if (around[i] == NO_NEIGHBOR || !isEmpty(around[i]) || group[i] != i) continue;
+        representative[distinct++] = around[i];
+    }
+    if (distinct <= 1) return;
+
+    // Bileşen bölünmüş olabilir: son grup dışındaki grupları taşkınla yeni köke taşı.
+    // Son grup eski kökte kalır; başka bir gruba bağlıysa taşkın onu da kapsar.
+    std::fill(visited.begin(), visited.end(), 0);
+    for (int i = 0; i + 1 < distinct; ++i) {
+        int start = representative[i];
+        if ((visited[start >> 6] >> (start & 63)) & 1) continue;
+        relabel(start);
+    }
+}
+
+void MoveValidator::relabel(int start) {
+    int root = newNode();
+    stack.clear();
+    stack.push_back(start);
+    visited[start >> 6] |= std::uint64_t(1) << (start & 63);
+    while (!stack.empty()) {
+        int sq = stack.back();
+        stack.pop_back();
+        node[sq] = root;
+        for (int n : ring(sq)) {
+            if (n == NO_NEIGHBOR || !isEmpty(n)) continue;
+            std::uint64_t bit = std::uint64_t(1) << (n & 63);
+            if (visited[n >> 6] & bit) continue;
+            visited[n >> 6] |= bit;
+            stack.push_back(n);
+        }
+    }
+}
+
+bool MoveValidator::isPathValid(const Position& from, const Position& to) {
+    if (!board.isPositionValid(from) || !board.isPositionValid(to)) return false;
+    int f = board.squareIndex(from.x, from.y);
+    int t = board.squareIndex(to.x, to.y);
+    if (f == t) return true;
+    if (!isEmpty(t)) return false;
+
+    // Başlangıç karesinden yalnızca boş komşulara geçilebilir
+    int target = find(node[t]);
+    for (int n : ring(f)) {
+        if (n != NO_NEIGHBOR && isEmpty(n) && find(node[n]) == target) return true;
+    }
     return false;
 }
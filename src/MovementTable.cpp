@@ -0,0 +1,127 @@
+#include "MovementTable.hpp"
+
+namespace {
+
+const int KNIGHT_DX[8] = {1, 2, 2, 1, -1, -2, -2, -1};
+const int KNIGHT_DY[8] = {2, 1, -1, -2, -2, -1, 1, 2};
+
+int clampRange(int range, int boardSize) {
+    return std::clamp(range, 0, boardSize - 1);
+}
+
+// (x, y)'den dir yönünde tahta kenarına kadar kaç kare var
+int edgeDistance(int x, int y, int dir, int boardSize) {
+    int edge = boardSize;
+    if (DIRECTION_DX[dir] > 0) edge = std::min(edge, boardSize - 1 - x);
+    if (DIRECTION_DX[dir] < 0) edge = std::min(edge, x);
+    if (DIRECTION_DY[dir] > 0) edge = std::min(edge, boardSize - 1 - y);
+    if (DIRECTION_DY[dir] < 0) edge = std::min(edge, y);
+    return edge;
+}
+
+} // namespace
+
+MovementTable::MovementTable(const PieceConfig &piece, int color, int boardSize)
+    : boardSize(boardSize), perDirection(boardSize * boardSize > MAX_TABLE_SQUARES) {
+    const auto &rules = piece.movement;
+    int squareCount = boardSize * boardSize;
+
+    // Piyon: ileri yalnızca kendi yönüne ve alış yapmadan, alışlar ileri çaprazlara
+    bool directional = piece.type == "Pawn";
+    int forwardDir = color == 0 ? 0 : 1;
+    startRank = color == 0 ? 1 : boardSize - 2;
+
+    // Sıradan bağımsız kırpılmamış ışın; yalnızca piyonun başlangıç sırasında farklıdır
+    auto rangeRay = [&](int d, bool onStartRank) {
+        int moveRange = 0;
+        int captureRange = 0;
+        int doubleStepFrom = NO_DOUBLE_STEP;
+
+        if (d < 2) {
+            if (!directional) {
+                moveRange = captureRange = rules.forward;
+            } else if (d == forwardDir) {
+                moveRange = rules.forward;
+                if (onStartRank && rules.first_move_forward > moveRange) {
+                    doubleStepFrom = clampRange(moveRange, boardSize);
+                    moveRange = rules.first_move_forward;
+                }
+            }
+        } else if (d < 4) {
+            moveRange = captureRange = rules.sideways;
+        } else {
+            moveRange = captureRange = rules.diagonal;
+            bool forwardDiagonal = DIRECTION_DY[d] == DIRECTION_DY[forwardDir];
+            if (directional && forwardDiagonal) {
+                captureRange = std::max(captureRange, rules.diagonal_capture);
+            }
+        }
+
+        Ray ray{};
+        ray.moveLength = static_cast<std::uint16_t>(clampRange(moveRange, boardSize));
+        ray.captureLength = static_cast<std::uint16_t>(clampRange(captureRange, boardSize));
+        ray.doubleStepFrom = static_cast<std::uint16_t>(doubleStepFrom);
+        ray.moveReach = static_cast<std::uint16_t>(std::clamp(moveRange, 0, 0xFFFF));
+        ray.captureReach = static_cast<std::uint16_t>(std::clamp(captureRange, 0, 0xFFFF));
+        return ray;
+    };
+
+    std::vector<Ray> ranges(2 * DIRECTION_COUNT);
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        ranges[d] = rangeRay(d, false);
+        ranges[DIRECTION_COUNT + d] = rangeRay(d, true);
+    }
+
+    if (perDirection) {
+        rays = std::move(ranges);
+    } else {
+        rays.resize(static_cast<std::size_t>(squareCount) * DIRECTION_COUNT);
+        for (int sq = 0; sq < squareCount; ++sq) {
+            int offset = sq / boardSize == startRank ? DIRECTION_COUNT : 0;
+            for (int d = 0; d < DIRECTION_COUNT; ++d) {
+                rays[static_cast<std::size_t>(sq) * DIRECTION_COUNT + d] = clip(ranges[offset + d], sq, d);
+            }
+        }
+    }
+
+    if (!rules.l_shape) return;
+    leapStart.assign(squareCount + 1, 0);
+    for (int sq = 0; sq < squareCount; ++sq) {
+        int x = sq % boardSize;
+        int y = sq / boardSize;
+        leapStart[sq] = static_cast<int>(leaps.size());
+        for (int i = 0; i < 8; ++i) {
+            int tx = x + KNIGHT_DX[i];
+            int ty = y + KNIGHT_DY[i];
+            if (tx >= 0 && tx < boardSize && ty >= 0 && ty < boardSize) {
+                leaps.push_back(ty * boardSize + tx);
+            }
+        }
+    }
+    leapStart[squareCount] = static_cast<int>(leaps.size());
+}
+
+MovementTable::MovementTable(int color, int boardSize, std::vector<Ray> rays, std::vector<int> leaps,
+                             std::vector<int> leapStart)
+    : boardSize(boardSize), startRank(color == 0 ? 1 : boardSize - 2),
+      perDirection(boardSize * boardSize > MAX_TABLE_SQUARES), rays(std::move(rays)), leaps(std::move(leaps)),
+      leapStart(std::move(leapStart)) {}
+
+std::size_t MovementTable::rayCount(int boardSize) {
+    std::size_t squareCount = static_cast<std::size_t>(boardSize) * boardSize;
+    return squareCount > MAX_TABLE_SQUARES ? 2 * DIRECTION_COUNT : squareCount * DIRECTION_COUNT;
+}
+
+MovementTable::Ray MovementTable::clippedRay(int sq, int dir) const {
+    return clip(rays[(sq / boardSize == startRank ? DIRECTION_COUNT : 0) + dir], sq, dir);
+}
+
+MovementTable::Ray MovementTable::clip(Ray ray, int sq, int dir) const {
+    // Tahta kenarına kadar kırp
+    int edge = edgeDistance(sq % boardSize, sq / boardSize, dir, boardSize);
+    ray.begin = sq;
+    ray.step = DIRECTION_DY[dir] * boardSize + DIRECTION_DX[dir];
+    ray.moveLength = static_cast<std::uint16_t>(std::min<int>(ray.moveLength, edge));
+    ray.captureLength = static_cast<std::uint16_t>(std::min<int>(ray.captureLength, edge));
+    return ray;
+}
@@ -0,0 +1,96 @@
+#include "Notation.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+
+namespace {
+
+bool isFileLetter(char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+std::string Notation::fileToString(int x) {
+    // Tablo sütunları gibi: a..z, aa..az, ba..zz, aaa..
+    std::string file;
+    for (int n = x + 1; n > 0; n = (n - 1) / 26) {
+        file += static_cast<char>('a' + (n - 1) % 26);
+    }
+    std::reverse(file.begin(), file.end());
+    return file;
+}
+
+std::string Notation::squareToString(int x, int y, int boardSize) {
+    return fileToString(x) + std::to_string(boardSize - y);
+}
+
+std::string Notation::moveToString(const Board &board, Move move) {
+    return squareToString(board.squareX(move.from()), board.squareY(move.from()), board.board_size) +
+           squareToString(board.squareX(move.to()), board.squareY(move.to()), board.board_size) +
+           ((move.flags() & Move::PORTAL) ? "*" : "");
+}
+
+bool Notation::parseSquare(std::string_view text, int boardSize, int &x, int &y) {
+    std::size_t letters = 0;
+    int file = 0;
+    while (letters < text.size() && isFileLetter(text[letters])) {
+        if (file > boardSize) return false;
+        file = file * 26 + (text[letters++] - 'a' + 1);
+    }
+    if (letters == 0 || letters == text.size()) return false;
+
+    int rank = 0;
+    for (std::size_t i = letters; i < text.size(); ++i) {
+        if (!isDigit(text[i]) || rank > boardSize) return false;
+        rank = rank * 10 + (text[i] - '0');
+    }
+
+    x = file - 1;
+    y = boardSize - rank;
+    return x < boardSize && rank >= 1 && rank <= boardSize;
+}
+
+bool Notation::parseMove(std::string_view text, int boardSize, int &x1, int &y1, int &x2, int &y2,
+                         bool *viaPortal) {
+    bool portal = !text.empty() && text.back() == '*';
+    if (portal) {
+        if (!viaPortal) return false;
+        text.remove_suffix(1);
+    }
+    if (viaPortal) *viaPortal = portal;
+
+    // Birinci karenin sıra numarasından sonraki ilk harf ikinci kareyi başlatır
+    std::size_t split = 0;
+    while (split < text.size() && isFileLetter(text[split])) ++split;
+    while (split < text.size() && isDigit(text[split])) ++split;
+
+    return parseSquare(text.substr(0, split), boardSize, x1, y1) &&
+           parseSquare(text.substr(split), boardSize, x2, y2);
+}
+
+bool Notation::playMoves(Board &board, const std::vector<std::string> &moves, std::string &error) {
+    Board::UndoRecord undo;
+    for (const auto &text : moves) {
+        int x1, y1, x2, y2;
+        bool viaPortal;
+        if (!parseMove(text, board.board_size, x1, y1, x2, y2, &viaPortal)) {
+            error = "Invalid move notation: " + text;
+            return false;
+        }
+        Rules::MoveError reason;
+        Move move = Rules::findLegalMove(board, board.squareIndex(x1, y1), board.squareIndex(x2, y2), viaPortal,
+                                         &reason);
+        if (move.isNone()) {
+            error = "Illegal move: " + text;
+            if (reason == Rules::MoveError::LEAVES_ROYAL_IN_CHECK) error += " (leaves royal piece in check)";
+            return false;
+        }
+        board.makeMove(move, undo);
+    }
+    return true;
+}
@@ -0,0 +1,242 @@
+#include "OpeningBook.hpp"
+#include "GameRecord.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+const char MAGIC[4] = {'C', 'B', 'O', 'K'};
+
+// Bir iş parçacığının aynı anda aldığı oyun sayısı
+constexpr std::size_t GAMES_PER_CHUNK = 256;
+
+struct Chunk {
+    std::size_t archive;
+    std::size_t offset;
+    std::uint64_t firstGame;
+    std::size_t games;
+};
+
+bool keyMoveLess(const OpeningBook::Entry &a, const OpeningBook::Entry &b) {
+    if (a.key != b.key) return a.key < b.key;
+    return a.move != b.move ? a.move < b.move : a.moveHigh < b.moveHigh;
+}
+
+// Sıralı girişlerde aynı (konum, hamle) çiftlerini topla
+void combine(std::vector<OpeningBook::Entry> &entries) {
+    std::sort(entries.begin(), entries.end(), keyMoveLess);
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        if (out > 0 && entries[out - 1].key == entries[i].key && entries[out - 1].move == entries[i].move &&
+            entries[out - 1].moveHigh == entries[i].moveHigh) {
+            auto &merged = entries[out - 1];
+            merged.games += entries[i].games;
+            merged.wins += entries[i].wins;
+            merged.draws += entries[i].draws;
+            merged.losses += entries[i].losses;
+        } else {
+            entries[out++] = entries[i];
+        }
+    }
+    entries.resize(out);
+}
+
+// Oyunun ilk maxPly yarım hamlesi için birer giriş ekle. Oyunun geri kalanı da yasallık için
+// oynanır; yasal olmayan hamlesi olan oyunun girişleri geri alınır.
+bool addGame(Board &board, const Board &start, const GameRecord::GameView &game, int maxPly,
+             std::vector<OpeningBook::Entry> &entries) {
+    board = start;
+    Board::UndoRecord undo;
+    RecordedMove recorded;
+    auto cursor = game.cursor();
+    std::size_t first = entries.size();
+
+    for (int ply = 0; cursor.next(recorded); ++ply) {
+        Move move = Rules::findLegalMove(board, recorded.from, recorded.to, recorded.viaPortal);
+        if (move.isNone()) {
+            entries.resize(first);
+            return false;
+        }
+        if (ply >= maxPly) {
+            board.makeMove(move, undo);
+            continue;
+        }
+
+        OpeningBook::Entry entry{board.key(), move.compact(), 1, 0, 0, 0, move.compactHigh()};
+        if (game.result == GameResult::DRAW) {
+            entry.draws = 1;
+        } else if (game.result != GameResult::UNKNOWN) {
+            bool whiteWon = game.result == GameResult::WHITE_WINS;
+            (whiteWon == board.whiteToMove ? entry.wins : entry.losses) = 1;
+        }
+        entries.push_back(entry);
+        board.makeMove(move, undo);
+    }
+    return true;
+}
+
+} // namespace
+
+bool OpeningBook::build(const Board &start, std::uint64_t variantHash, const std::vector<std::string> &archivePaths,
+                        const std::string &bookPath, const BuildOptions &options, BuildStats &stats,
+                        std::string &error) {
+    stats = BuildStats();
+
+    // Arşivleri parçalara böl: iş parçacıkları her parçayı kendi eşlemesinden okur
+    std::vector<Chunk> chunks;
+    for (std::size_t a = 0; a < archivePaths.size(); ++a) {
+        GameRecordReader scan;
+        if (!scan.open(archivePaths[a])) {
+            error = scan.error();
+            return false;
+        }
+        if (scan.variantHash() != variantHash) {
+            error = archivePaths[a] + " was recorded for a different variant";
+            return false;
+        }
+        GameRecord::GameView game;
+        for (std::size_t offset = scan.offset(); scan.next(game); offset = scan.offset()) {
+            if (game.index % GAMES_PER_CHUNK == 0) chunks.push_back({a, offset, game.index, 0});
+            ++chunks.back().games;
+            ++stats.games;
+        }
+        if (!scan.error().empty()) {
+            error = scan.error();
+            return false;
+        }
+    }
+
+    int jobs = std::max(options.jobs, 1);
+    std::vector<std::vector<Entry>> partial(static_cast<std::size_t>(jobs));
+    std::atomic<std::size_t> nextChunk{0};
+    std::atomic<std::uint64_t> skipped{0};
+
+    auto worker = [&](int id) {
+        auto &entries = partial[id];
+        Board board = start;
+        GameRecordReader reader;
+        std::size_t openArchive = archivePaths.size();
+        GameRecord::GameView game;
+
+        for (std::size_t c = nextChunk++; c < chunks.size(); c = nextChunk++) {
+            const Chunk &chunk = chunks[c];
+            if (chunk.archive != openArchive) {
+                if (!reader.open(archivePaths[chunk.archive])) continue;
+                openArchive = chunk.archive;
+            }
+            reader.seek(chunk.offset, chunk.firstGame);
+            for (std::size_t i = 0; i < chunk.games && reader.next(game); ++i) {
+                if (!addGame(board, start, game, options.maxPly, entries)) ++skipped;
+            }
+        }
+        combine(entries);
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < jobs; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<Entry> entries = std::move(partial[0]);
+    for (int t = 1; t < jobs; ++t) {
+        entries.insert(entries.end(), partial[t].begin(), partial[t].end());
+        std::vector<Entry>().swap(partial[t]);
+    }
+    combine(entries);
+
+    for (const auto &entry : entries) stats.moves += entry.games;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&](const Entry &entry) {
+                                     return entry.games < static_cast<std::uint32_t>(std::max(options.minGames, 1));
+                                 }),
+                  entries.end());
+    stats.entries = entries.size();
+    stats.skippedGames = skipped;
+
+    std::uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    std::uint16_t version = VERSION;
+    std::uint64_t entryCount = entries.size();
+    std::memcpy(header + 4, &version, sizeof(version));
+    std::memcpy(header + 8, &variantHash, sizeof(variantHash));
+    std::memcpy(header + 16, &entryCount, sizeof(entryCount));
+
+    std::ofstream out(bookPath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+    if (!out.good()) {
+        error = "failed to write " + bookPath;
+        return false;
+    }
+    return true;
+}
+
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+bool OpeningBook::open(const std::string &path) {
+    close();
+
+    if (!file.map(path, HEADER_SIZE, "an opening book", lastError)) return false;
+
+    const std::uint8_t *data = file.data();
+    std::uint16_t version;
+    std::memcpy(&version, data + 4, sizeof(version));
+    std::memcpy(&hash, data + 8, sizeof(hash));
+    std::memcpy(&count, data + 16, sizeof(count));
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+        count > (file.size() - HEADER_SIZE) / sizeof(Entry)) {
+        close();
+        lastError = path + " is not a version " + std::to_string(VERSION) + " opening book";
+        return false;
+    }
+
+    entries = reinterpret_cast<const Entry *>(data + HEADER_SIZE);
+    lastError.clear();
+    return true;
+}
+
+void OpeningBook::close() {
+    file.unmap();
+    entries = nullptr;
+    count = 0;
+}
+
+std::pair<const OpeningBook::Entry *, const OpeningBook::Entry *> OpeningBook::find(std::uint64_t key) const {
+    const Entry *end = entries + count;
+    auto first = std::lower_bound(entries, end, key, [](const Entry &entry, std::uint64_t k) { return entry.key < k; });
+    auto last = std::upper_bound(first, end, key, [](std::uint64_t k, const Entry &entry) { return k < entry.key; });
+    return {first, last};
+}
+
+Move OpeningBook::probe(Board &board) const {
+    auto [first, last] = find(board.key());
+    if (first == last) return Move();
+
+    // Anahtar çakışmasına karşı hamle o konumda yasal olmalı
+    MoveList legal;
+    Rules::generateLegalMoves(board, board.whiteToMove, legal);
+
+    const Entry *best = nullptr;
+    Move bestMove;
+    for (const Entry *entry = first; entry != last; ++entry) {
+        Move move = entry->toMove();
+        if (!legal.contains(move)) continue;
+        if (!best || entry->games > best->games || (entry->games == best->games && entry->score() > best->score())) {
+            best = entry;
+            bestMove = move;
+        }
+    }
+    return bestMove;
+}
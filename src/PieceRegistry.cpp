@@ -0,0 +1,73 @@
+#include "PieceRegistry.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+PieceRegistry::PieceRegistry(const std::vector<PieceConfig> &pieces, int boardSize,
+                             std::vector<MovementTable> compiled) {
+    standardKernel = StandardKernel::matches(pieces, boardSize);
+    kernelTypes.fill(-1);
+
+    for (const auto &piece : pieces) {
+        if (find(piece.type) >= 0) continue;
+
+        PieceType type;
+        type.name = piece.type;
+        type.symbol = piece.type == "Knight" ? 'N' : piece.type.empty() ? '?' : piece.type[0];
+        type.movement = piece.movement;
+
+        const auto &abilities = piece.special_abilities;
+        if (abilities.castling) type.abilities |= CASTLING;
+        if (abilities.royal || piece.type == "King") type.abilities |= ROYAL;
+        if (abilities.jump_over) type.abilities |= JUMP_OVER;
+        if (abilities.promotion) type.abilities |= PROMOTION;
+        if (abilities.en_passant) type.abilities |= EN_PASSANT;
+        if (piece.type == "Pawn") type.abilities |= PAWN_MOVES;
+
+        for (const auto &[name, enabled] : abilities.custom_abilities) {
+            if (!enabled) continue;
+            auto it = std::find(customAbilityNames.begin(), customAbilityNames.end(), name);
+            if (it == customAbilityNames.end()) {
+                if (customAbilityNames.size() >= 64 - CUSTOM_SHIFT) {
+                    std::cerr << "Too many custom abilities, ignoring: " << name << "\n";
+                    continue;
+                }
+                it = customAbilityNames.insert(customAbilityNames.end(), name);
+            }
+            type.abilities |= 1ull << (CUSTOM_SHIFT + (it - customAbilityNames.begin()));
+        }
+
+        for (int color = 0; color < 2; ++color) {
+            std::size_t slot = static_cast<std::size_t>(size()) * 2 + color;
+            type.moves[color] = slot < compiled.size()
+                                    ? std::make_unique<const MovementTable>(std::move(compiled[slot]))
+                                    : std::make_unique<const MovementTable>(piece, color, boardSize);
+        }
+
+        if (standardKernel) {
+            type.kind = StandardKernel::kindOf(piece);
+            kernelTypes[type.kind] = size();
+        }
+        types.push_back(std::move(type));
+    }
+}
+
+PieceRegistry::PieceRegistry(const GameConfig &config)
+    : PieceRegistry([&config] {
+          std::vector<PieceConfig> all = config.pieces;
+          all.insert(all.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+          return all;
+      }(), config.game_settings.board_size) {}
+
+int PieceRegistry::find(const std::string &name) const {
+    for (int i = 0; i < size(); ++i) {
+        if (types[i].name == name) return i;
+    }
+    return -1;
+}
+
+std::uint64_t PieceRegistry::customAbility(const std::string &name) const {
+    auto it = std::find(customAbilityNames.begin(), customAbilityNames.end(), name);
+    if (it == customAbilityNames.end()) return 0;
+    return 1ull << (CUSTOM_SHIFT + (it - customAbilityNames.begin()));
+}
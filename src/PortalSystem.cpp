@@ -1,76 +1,156 @@
 #include "PortalSystem.hpp"
 #include <algorithm>
+#include <iostream>
 
-PortalSystem::PortalSystem() {}
-
-void PortalSystem::addPortal(const Position& entry, const Position& exit, bool isTwoWay)
+PortalSystem::PortalSystem(const std::vector<PortalConfig>& portals, int boardSize)
+    : configs(portals)
 {
-    Portal portal = { entry, exit, isTwoWay };
-    portals.push_back(portal);
-    portalMap[entry] = portal;
+    int n = count();
+    entries.assign(n, -1);
+    exits.assign(n, -1);
+    colorMask.assign(n, 0);
+    entryHead.assign(static_cast<size_t>(boardSize) * boardSize, -1);
+    entryNext.assign(n, -1);
+    exitHead.assign(static_cast<size_t>(boardSize) * boardSize, -1);
+    exitNext.assign(n, -1);
+    exposure.assign(static_cast<size_t>(boardSize) * boardSize, 0);
+    continuationDirs.assign(static_cast<size_t>(boardSize) * boardSize, 0);
+    cooldownUntil.assign(n, 0);
+    activeIndex.assign(n, -1);
+
+    auto onBoard = [boardSize](const Position& pos)
+    {
+        return pos.x >= 0 && pos.x < boardSize && pos.y >= 0 && pos.y < boardSize;
+    };
 
-    if (isTwoWay)
+    int longest = 0;
+    // Zincirde yapılandırma sırası korunsun diye sondan başa eklenir
+    for (int i = n - 1; i >= 0; --i)
     {
-        Portal reversePortal = { exit, entry, isTwoWay };
-        portals.push_back(reversePortal);
-        portalMap[exit] = reversePortal;
+        const auto& portal = configs[i];
+        longest = std::max(longest, portal.properties.cooldown);
+        for (const auto& color : portal.properties.allowed_colors)
+        {
+            if (color == "white") colorMask[i] |= 1;
+            else if (color == "black") colorMask[i] |= 2;
+        }
+
+        if (!onBoard(portal.positions.entry) || !onBoard(portal.positions.exit))
+        {
+            std::cerr << "Portal " << portal.id << " is outside the board, ignoring it.\n";
+            continue;
+        }
+        entries[i] = portal.positions.entry.y * boardSize + portal.positions.entry.x;
+        exits[i] = portal.positions.exit.y * boardSize + portal.positions.exit.x;
+        entryNext[i] = entryHead[entries[i]];
+        entryHead[entries[i]] = i;
+        exitNext[i] = exitHead[exits[i]];
+        exitHead[exits[i]] = i;
+
+        exposure[exits[i]] |= colorMask[i];
+        if (portal.properties.preserve_direction)
+        {
+            continuations = true;
+            for (int d = 0; d < DIRECTION_COUNT; ++d)
+            {
+                for (int x = portal.positions.exit.x + DIRECTION_DX[d], y = portal.positions.exit.y + DIRECTION_DY[d];
+                     onBoard({x, y}); x += DIRECTION_DX[d], y += DIRECTION_DY[d])
+                {
+                    exposure[y * boardSize + x] |= colorMask[i];
+                }
+                // Girişe d yönünde gelen karelerin hepsi girişin tersi yöndeki doğrudadır
+                int back = oppositeDirection(d);
+                for (int x = portal.positions.entry.x + DIRECTION_DX[back], y = portal.positions.entry.y + DIRECTION_DY[back];
+                     onBoard({x, y}); x += DIRECTION_DX[back], y += DIRECTION_DY[back])
+                {
+                    continuationDirs[y * boardSize + x] |= static_cast<std::uint8_t>(1u << d);
+                }
+            }
+        }
     }
+
+    // Süren beklemelerin bitişleri (ply, ply + en uzun + 1] aralığındadır; çark bu aralığı
+    // kapsayan ikinin kuvveti kadar yuva tutar
+    int size = 1;
+    while (size < longest + 2) size <<= 1;
+    wheel.assign(size, {});
+    wheelMask = size - 1;
 }
 
-bool PortalSystem::canUsePortal(const Position& pos) const
+int PortalSystem::startCooldown(int portal, int ply)
 {
-    return portalMap.find(pos) != portalMap.end() && !isOnCooldown(pos);
+    int previous = cooldownUntil[portal];
+    removeFromWheel(portal);
+    cooldownUntil[portal] = ply + 1 + std::max(0, configs[portal].properties.cooldown);
+    addToWheel(portal);
+    addActive(portal);
+    return previous;
 }
 
-Position PortalSystem::getTeleportExit(const Position& entry, const Position& direction) const
+void PortalSystem::restoreCooldown(int portal, int previousUntil)
 {
-    auto it = portalMap.find(entry);
-    if (it != portalMap.end())
-    {
-
-        return it->second.exit;
-    }
-    return entry;
+    removeActive(portal);
+    removeFromWheel(portal);
+    cooldownUntil[portal] = previousUntil;
+    addToWheel(portal);
 }
 
-void PortalSystem::applyCooldown(const Position& entry)
+void PortalSystem::setCooldown(int portal, int until, int ply)
 {
-    CooldownEntry entryCooldown = { entry, 2 }; 
-    cooldownQueue.push(entryCooldown);
+    removeFromWheel(portal);
+    cooldownUntil[portal] = until;
+    addToWheel(portal);
+    if (until > ply) addActive(portal);
+    else removeActive(portal);
 }
 
-void PortalSystem::decrementCooldowns()
+void PortalSystem::tick(int ply)
 {
-    size_t size = cooldownQueue.size();
-    std::queue<CooldownEntry> updatedQueue;
-
-    for (size_t i = 0; i < size; ++i)
+    for (int portal : wheel[ply & wheelMask])
     {
-        CooldownEntry cooldown = cooldownQueue.front();
-        cooldownQueue.pop();
-        cooldown.remainingTurns--;
+        if (cooldownUntil[portal] == ply) removeActive(portal);
+    }
+}
 
-        if (cooldown.remainingTurns > 0)
-        {
-            updatedQueue.push(cooldown);
-        }
+void PortalSystem::untick(int ply)
+{
+    for (int portal : wheel[ply & wheelMask])
+    {
+        if (cooldownUntil[portal] == ply) addActive(portal);
     }
+}
+
+void PortalSystem::addActive(int portal)
+{
+    if (activeIndex[portal] >= 0) return;
+    activeIndex[portal] = static_cast<int>(active.size());
+    active.push_back(portal);
+}
 
-    cooldownQueue = updatedQueue;
+void PortalSystem::removeActive(int portal)
+{
+    int index = activeIndex[portal];
+    if (index < 0) return;
+    int last = active.back();
+    active[index] = last;
+    activeIndex[last] = index;
+    active.pop_back();
+    activeIndex[portal] = -1;
 }
 
-bool PortalSystem::isOnCooldown(const Position& pos) const
+void PortalSystem::addToWheel(int portal)
 {
-    std::queue<CooldownEntry> temp = cooldownQueue;
+    if (cooldownUntil[portal] > 0) wheel[cooldownUntil[portal] & wheelMask].push_back(portal);
+}
 
-    while (!temp.empty())
+void PortalSystem::removeFromWheel(int portal)
+{
+    if (cooldownUntil[portal] <= 0) return;
+    auto& slot = wheel[cooldownUntil[portal] & wheelMask];
+    auto it = std::find(slot.begin(), slot.end(), portal);
+    if (it != slot.end())
     {
-        if (temp.front().portalEntry.x == pos.x && temp.front().portalEntry.y == pos.y)
-        {
-            return true;
-        }
-        temp.pop();
+        *it = slot.back();
+        slot.pop_back();
     }
-
-    return false;
 }
@@ -0,0 +1,299 @@
+#include "PositionIndex.hpp"
+#include "GameRecord.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char MAGIC[4] = {'C', 'P', 'I', 'X'};
+
+// Bir iş parçacığının aynı anda aldığı oyun sayısı
+constexpr std::size_t GAMES_PER_CHUNK = 256;
+
+// Birleştirmede her geçici dosyadan okunan blok
+constexpr std::size_t RUN_BLOCK = 4096;
+
+void encodeHeader(std::uint8_t *header, std::uint64_t variantHash, std::uint64_t entries, std::uint64_t games) {
+    std::memset(header, 0, PositionIndex::HEADER_SIZE);
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    std::uint16_t version = PositionIndex::VERSION;
+    std::memcpy(header + 4, &version, sizeof(version));
+    std::memcpy(header + 8, &variantHash, sizeof(variantHash));
+    std::memcpy(header + 16, &entries, sizeof(entries));
+    std::memcpy(header + 24, &games, sizeof(games));
+}
+
+std::string runPath(const std::string &indexPath, int run) {
+    return indexPath + ".run" + std::to_string(run);
+}
+
+// Sıralı bir geçici dosyayı bloklar halinde okur
+class RunReader {
+public:
+    explicit RunReader(const std::string &path) : in(path, std::ios::binary), buffer(RUN_BLOCK) {}
+
+    bool next(PositionEntry &entry) {
+        if (position == filled) {
+            in.read(reinterpret_cast<char *>(buffer.data()),
+                    static_cast<std::streamsize>(buffer.size() * sizeof(PositionEntry)));
+            filled = static_cast<std::size_t>(in.gcount()) / sizeof(PositionEntry);
+            position = 0;
+            if (filled == 0) return false;
+        }
+        entry = buffer[position++];
+        return true;
+    }
+
+private:
+    std::ifstream in;
+    std::vector<PositionEntry> buffer;
+    std::size_t position = 0;
+    std::size_t filled = 0;
+};
+
+// Oyunları oynayıp girişleri biriktiren, bellek payı dolunca sıralı geçici dosya yazan iş parçacığı
+class RunBuilder {
+public:
+    RunBuilder(const Board &start, std::size_t capacity, const std::string &indexPath, std::atomic<int> &runCounter,
+               std::vector<std::string> &runPaths, std::mutex &runMutex)
+        : board(start), start(start), capacity(capacity), indexPath(indexPath), runCounter(runCounter),
+          runPaths(runPaths), runMutex(runMutex) {
+        buffer.reserve(capacity);
+    }
+
+    // Oyunu baştan oynar; arşivde oynanamayan bir hamle varsa oyun o noktada kesilir
+    bool addGame(const GameRecord::GameView &game) {
+        board = start;
+        Board::UndoRecord undo;
+        std::uint32_t ply = 0;
+        push(game.index, ply);
+
+        RecordedMove recorded;
+        auto cursor = game.cursor();
+        while (cursor.next(recorded)) {
+            Move move = Rules::findLegalMove(board, recorded.from, recorded.to, recorded.viaPortal);
+            if (move.isNone()) return false;
+            board.makeMove(move, undo);
+            push(game.index, ++ply);
+        }
+        return true;
+    }
+
+    bool flush() {
+        if (buffer.empty()) return true;
+        std::sort(buffer.begin(), buffer.end());
+
+        int run = runCounter++;
+        std::string path = runPath(indexPath, run);
+        {
+            std::lock_guard<std::mutex> lock(runMutex);
+            runPaths.push_back(path);
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(buffer.data()),
+                  static_cast<std::streamsize>(buffer.size() * sizeof(PositionEntry)));
+        positions += buffer.size();
+        buffer.clear();
+        return out.good();
+    }
+
+    std::uint64_t positions = 0;
+    bool failed = false;
+
+private:
+    Board board;
+    const Board &start;
+    std::vector<PositionEntry> buffer;
+    std::size_t capacity;
+    const std::string &indexPath;
+    std::atomic<int> &runCounter;
+    std::vector<std::string> &runPaths;
+    std::mutex &runMutex;
+
+    void push(std::uint64_t game, std::uint32_t ply) {
+        buffer.push_back({board.key(), static_cast<std::uint32_t>(game), ply});
+        if (buffer.size() >= capacity && !flush()) failed = true;
+    }
+};
+
+// Sıralı geçici dosyaları tek sıralı dizine birleştir
+bool mergeRuns(const std::vector<std::string> &runPaths, const std::string &indexPath, std::uint64_t variantHash,
+               std::uint64_t games, std::uint64_t &written) {
+    std::ofstream out(indexPath, std::ios::binary | std::ios::trunc);
+    std::uint8_t header[PositionIndex::HEADER_SIZE];
+    encodeHeader(header, variantHash, 0, games);
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+    std::vector<std::unique_ptr<RunReader>> runs;
+    using Head = std::pair<PositionEntry, std::size_t>;
+    auto later = [](const Head &a, const Head &b) { return b.first < a.first; };
+    std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+
+    for (const auto &path : runPaths) {
+        runs.push_back(std::make_unique<RunReader>(path));
+        PositionEntry entry;
+        if (runs.back()->next(entry)) heads.push({entry, runs.size() - 1});
+    }
+
+    std::vector<PositionEntry> block;
+    block.reserve(RUN_BLOCK);
+    written = 0;
+    while (!heads.empty()) {
+        Head head = heads.top();
+        heads.pop();
+        block.push_back(head.first);
+        if (block.size() == RUN_BLOCK) {
+            out.write(reinterpret_cast<const char *>(block.data()),
+                      static_cast<std::streamsize>(block.size() * sizeof(PositionEntry)));
+            written += block.size();
+            block.clear();
+        }
+        PositionEntry entry;
+        if (runs[head.second]->next(entry)) heads.push({entry, head.second});
+    }
+    out.write(reinterpret_cast<const char *>(block.data()),
+              static_cast<std::streamsize>(block.size() * sizeof(PositionEntry)));
+    written += block.size();
+
+    encodeHeader(header, variantHash, written, games);
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    return out.good();
+}
+
+} // namespace
+
+bool PositionIndex::build(const Board &start, std::uint64_t variantHash, const std::string &archivePath,
+                          const std::string &indexPath, int jobs, std::size_t memoryMb, BuildStats &stats,
+                          std::string &error) {
+    stats = BuildStats();
+    jobs = std::max(jobs, 1);
+
+    // Oyunların başlangıç ofsetleri: iş parçacıkları arşivin istedikleri yerinden okur
+    GameRecordReader scan;
+    if (!scan.open(archivePath)) {
+        error = scan.error();
+        return false;
+    }
+    if (scan.variantHash() != variantHash) {
+        error = archivePath + " was recorded for a different variant";
+        return false;
+    }
+    std::vector<std::size_t> offsets;
+    GameRecord::GameView game;
+    for (std::size_t offset = scan.offset(); scan.next(game); offset = scan.offset()) {
+        offsets.push_back(offset);
+    }
+    if (!scan.error().empty()) {
+        error = scan.error();
+        return false;
+    }
+    scan.close();
+    stats.games = offsets.size();
+
+    std::size_t capacity = std::max<std::size_t>(memoryMb * 1024 * 1024 / sizeof(PositionEntry) / jobs, RUN_BLOCK);
+    std::atomic<int> runCounter{0};
+    std::vector<std::string> runPaths;
+    std::mutex runMutex;
+    std::atomic<std::size_t> nextChunk{0};
+    std::atomic<std::uint64_t> positions{0};
+    std::atomic<std::uint64_t> skipped{0};
+    std::atomic<bool> failed{false};
+
+    auto worker = [&]() {
+        GameRecordReader reader;
+        if (!reader.open(archivePath)) {
+            failed = true;
+            return;
+        }
+        RunBuilder builder(start, capacity, indexPath, runCounter, runPaths, runMutex);
+        GameRecord::GameView view;
+        for (std::size_t chunk = nextChunk++; chunk * GAMES_PER_CHUNK < offsets.size(); chunk = nextChunk++) {
+            std::size_t first = chunk * GAMES_PER_CHUNK;
+            std::size_t last = std::min(first + GAMES_PER_CHUNK, offsets.size());
+            reader.seek(offsets[first], first);
+            for (std::size_t i = first; i < last && reader.next(view); ++i) {
+                if (!builder.addGame(view)) ++skipped;
+            }
+        }
+        if (!builder.flush() || builder.failed) failed = true;
+        positions += builder.positions;
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < jobs; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    stats.runs = static_cast<int>(runPaths.size());
+    stats.skippedGames = skipped;
+
+    std::uint64_t written = 0;
+    bool ok = !failed && mergeRuns(runPaths, indexPath, variantHash, stats.games, written);
+    for (const auto &path : runPaths) {
+        std::remove(path.c_str());
+    }
+    if (!ok || written != positions) {
+        error = "failed to write " + indexPath;
+        return false;
+    }
+    stats.positions = written;
+    return true;
+}
+
+PositionIndex::~PositionIndex() {
+    close();
+}
+
+bool PositionIndex::open(const std::string &path) {
+    close();
+
+    if (!file.map(path, HEADER_SIZE, "a position index", lastError)) return false;
+
+    const std::uint8_t *data = file.data();
+    std::uint16_t version;
+    std::memcpy(&version, data + 4, sizeof(version));
+    std::memcpy(&hash, data + 8, sizeof(hash));
+    std::memcpy(&count, data + 16, sizeof(count));
+    std::memcpy(&games, data + 24, sizeof(games));
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+        count > (file.size() - HEADER_SIZE) / sizeof(PositionEntry)) {
+        close();
+        lastError = path + " is not a version " + std::to_string(VERSION) + " position index";
+        return false;
+    }
+
+    entries = reinterpret_cast<const PositionEntry *>(data + HEADER_SIZE);
+    lastError.clear();
+    return true;
+}
+
+void PositionIndex::close() {
+    file.unmap();
+    entries = nullptr;
+    count = 0;
+}
+
+std::pair<const PositionEntry *, const PositionEntry *> PositionIndex::find(std::uint64_t key) const {
+    const PositionEntry *end = entries + count;
+    auto first = std::lower_bound(entries, end, key,
+                                  [](const PositionEntry &entry, std::uint64_t k) { return entry.key < k; });
+    auto last = std::upper_bound(first, end, key,
+                                 [](std::uint64_t k, const PositionEntry &entry) { return k < entry.key; });
+    return {first, last};
+}
@@ -2,87 +2,435 @@
 #include "Board.hpp"
 #include "ConfigReader.hpp"
 #include <iostream>
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstdint>
 
-bool Rules::isCheck(const Board& board, bool isWhiteTurn) {
-    Position kingPosition = { -1, -1 };
-
-    for (int y = 0; y < board.board_size; ++y) {
-        for (int x = 0; x < board.board_size; ++x) {
-            auto piece = board.getPiece(board.getKey(x, y));
-            if (piece && piece->type == "King" && piece->getIsWhite() == isWhiteTurn) {
-                kingPosition = { x, y };
-                break;
-            }
-        }
+namespace {
+
+// from'daki taş dir yönünde distance uzaklığa kadar alış yapabilir mi (aradaki kareler hariç)
+bool reaches(const Board& board, int from, int dir, int distance) {
+    return board.movementOf(board.codeAt(from)).ray(from, dir).captureLength >= distance;
+}
+
+int chebyshev(const Board& board, int a, int b) {
+    return std::max(std::abs(board.squareX(a) - board.squareX(b)), std::abs(board.squareY(a) - board.squareY(b)));
+}
+
+// t, a ile b arasında mı (uçlar hariç)
+bool isStrictlyBetween(const Board& board, int a, int b, int t) {
+    int dirB = directionBetween(board.squareX(b) - board.squareX(a), board.squareY(b) - board.squareY(a));
+    int dirT = directionBetween(board.squareX(t) - board.squareX(a), board.squareY(t) - board.squareY(a));
+    return dirB >= 0 && dirB == dirT && chebyshev(board, a, t) < chebyshev(board, a, b);
+}
+
+// from karesindeki taş to karesindeki rakip taşı alabilir mi
+bool attacks(const Board& board, int from, int to, int ignoreSq) {
+    if (board.usesStandardKernel()) {
+        Board::PieceCode code = board.codeAt(from);
+        std::uint64_t occupied = board.kernelBitboards().occupied.words[0];
+        if (ignoreSq >= 0) occupied &= ~StandardKernel::bit(ignoreSq);
+        return (StandardKernel::attacksFrom(board.kernelKind(code), Board::colorOf(code), from, occupied) &
+                StandardKernel::bit(to)) != 0;
+    }
+
+    const MovementTable& table = board.movementOf(board.codeAt(from));
+    if (std::find(table.leapsBegin(from), table.leapsEnd(from), to) != table.leapsEnd(from)) {
+        return true;
+    }
+    int dir = directionBetween(board.squareX(to) - board.squareX(from), board.squareY(to) - board.squareY(from));
+    return dir >= 0 && reaches(board, from, dir, chebyshev(board, from, to)) && board.isPathClear(from, to, ignoreSq);
+}
+
+// Kral from'dan to'ya giderken arkasında kalan ve artık to'yu gören kayan rakip taş var mı.
+// Saldırı haritası kralı engel saydığından bu durum haritada görünmez.
+bool attackedThroughKing(const Board& board, int king, int to, int enemyColor) {
+    int dir = directionBetween(board.squareX(king) - board.squareX(to), board.squareY(king) - board.squareY(to));
+    if (dir < 0) return false;
+    int distance = 0;
+    int sq = board.firstOccupied(king, dir, distance);
+    return sq >= 0 && Board::colorOf(board.codeAt(sq)) == enemyColor &&
+           reaches(board, sq, oppositeDirection(dir), chebyshev(board, sq, to));
+}
+
+// Standart 8x8 takımda hedefler derleme zamanı tablolarından gelir
+template <typename Emit>
+bool generateStandardMoves(const Board& board, int from, Emit&& emit) {
+    Board::PieceCode mover = board.codeAt(from);
+    int color = Board::colorOf(mover);
+    StandardKernel::Kind kind = board.kernelKind(mover);
+    const auto& set = board.kernelBitboards();
+    std::uint64_t occupied = set.occupied.words[0];
+
+    std::uint64_t reach = StandardKernel::attacksFrom(kind, color, from, occupied);
+    for (std::uint64_t captures = reach & set.byColor[color ^ 1].words[0]; captures; captures &= captures - 1) {
+        if (emit(from, std::countr_zero(captures), Move::CAPTURE)) return true;
     }
 
-    if (kingPosition.x == -1)
+    if (kind != StandardKernel::PAWN) {
+        for (std::uint64_t quiets = reach & ~occupied; quiets; quiets &= quiets - 1) {
+            if (emit(from, std::countr_zero(quiets), 0u)) return true;
+        }
         return false;
+    }
+
+    int step = color == Board::WHITE ? StandardKernel::SIZE : -StandardKernel::SIZE;
+    int single = from + step;
+    if (single < 0 || single >= StandardKernel::SQUARES || (occupied & StandardKernel::bit(single))) return false;
+    if (emit(from, single, 0u)) return true;
+
+    int startRank = color == Board::WHITE ? 1 : StandardKernel::SIZE - 2;
+    int pushed = single + step;
+    if (from / StandardKernel::SIZE == startRank && !(occupied & StandardKernel::bit(pushed))) {
+        if (emit(from, pushed, Move::DOUBLE_STEP)) return true;
+    }
+    return false;
+}
+
+// Tabloya dayalı genel hamle üretimi
+template <typename Emit>
+bool generateTableMoves(const Board& board, int from, Emit&& emit) {
+    Board::PieceCode mover = board.codeAt(from);
+    const MovementTable& table = board.movementOf(mover);
+    int color = Board::colorOf(mover);
 
-    for (int y = 0; y < board.board_size; ++y) {
-        for (int x = 0; x < board.board_size; ++x) {
-            auto piece = board.getPiece(board.getKey(x, y));
-            if (piece && piece->getIsWhite() != isWhiteTurn) {
-                if (isValidMove(board, x, y, kingPosition.x, kingPosition.y)) {
-                    return true;
+    for (const int* target = table.leapsBegin(from); target != table.leapsEnd(from); ++target) {
+        Board::PieceCode code = board.codeAt(*target);
+        if (code == Board::EMPTY) {
+            if (emit(from, *target, 0u)) return true;
+        } else if (Board::colorOf(code) != color) {
+            if (emit(from, *target, Move::CAPTURE)) return true;
+        }
+    }
+
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        const auto& ray = table.ray(from, d);
+        int length = ray.length();
+        for (int i = 0; i < length; ++i) {
+            int to = table.target(ray, i);
+            Board::PieceCode code = board.codeAt(to);
+            if (code == Board::EMPTY) {
+                if (i < ray.moveLength) {
+                    std::uint32_t flags = i >= ray.doubleStepFrom ? Move::DOUBLE_STEP : 0u;
+                    if (emit(from, to, flags)) return true;
                 }
+                continue;
             }
+            if (Board::colorOf(code) != color && i < ray.captureLength && emit(from, to, Move::CAPTURE)) return true;
+            break;
         }
     }
 
     return false;
 }
 
-bool Rules::isCheckmate(const Board& board, bool isWhiteTurn) {
-    if (!isCheck(board, isWhiteTurn))
-        return false;
+// from karesindeki taşın sözde yasal hamleleri; emit true dönerse üretim durur.
+// Portal girişine inip çıkışta taş alan hamleler CAPTURE, yön koruyan portaldan devam
+// edenler PORTAL bayrağı taşır.
+template <typename Emit>
+bool generatePieceMoves(const Board& board, int from, Emit&& emit) {
+    if (board.portals.count() == 0) {
+        return board.usesStandardKernel() ? generateStandardMoves(board, from, emit) : generateTableMoves(board, from, emit);
+    }
+
+    auto emitHop = [&](int f, int t, std::uint32_t flags) {
+        if (!(flags & Move::CAPTURE) && board.isPortalEntry(t) && board.victimOf(Move(f, t)) != Board::EMPTY) {
+            flags |= Move::CAPTURE;
+        }
+        return emit(f, t, flags);
+    };
+    bool stopped = board.usesStandardKernel() ? generateStandardMoves(board, from, emitHop)
+                                              : generateTableMoves(board, from, emitHop);
+    if (stopped || !board.portals.hasContinuations()) return stopped;
 
-    for (int y = 0; y < board.board_size; ++y) {
-        for (int x = 0; x < board.board_size; ++x) {
-            auto piece = board.getPiece(board.getKey(x, y));
-            if (piece && piece->getIsWhite() == isWhiteTurn) {
-                for (int targetY = 0; targetY < board.board_size; ++targetY) {
-                    for (int targetX = 0; targetX < board.board_size; ++targetX) {
-                        Board testBoard = board.clone();
-                        if (testBoard.movePieceForCloneBoard(x, y, targetX, targetY) &&
-                            !isCheck(testBoard, isWhiteTurn)) {
-                            return false;
-                        }
-                    }
+    // Aynı hedefe giden ikinci yol ayrı bir hamle sayılmaz. Hedefler önce küçük bir yığın
+    // tamponunda aranır; tampon dolarsa kare başına bir bitlik haritaya geçilir.
+    constexpr int SEEN_INLINE = 256;
+    int seen[SEEN_INLINE];
+    int seenCount = 0;
+    std::vector<std::uint64_t> seenMap;
+    auto firstVisit = [&](int t) {
+        if (seenMap.empty()) {
+            if (std::find(seen, seen + seenCount, t) != seen + seenCount) return false;
+            if (seenCount < SEEN_INLINE) {
+                seen[seenCount++] = t;
+                return true;
+            }
+            seenMap.assign((static_cast<std::size_t>(board.board_size) * board.board_size + 63) / 64, 0);
+            for (int i = 0; i < seenCount; ++i) {
+                seenMap[seen[i] >> 6] |= std::uint64_t(1) << (seen[i] & 63);
+            }
+        }
+        std::uint64_t bit = std::uint64_t(1) << (t & 63);
+        if (seenMap[t >> 6] & bit) return false;
+        seenMap[t >> 6] |= bit;
+        return true;
+    };
+    return board.forEachPortalContinuation(from, [&](int, int t, std::uint32_t flags) {
+        return firstVisit(t) && emit(from, t, flags);
+    });
+}
+
+// color rengindeki bir taş sq üzerindeki taşı portal üzerinden alabilir mi
+bool attackedThroughPortal(const Board& board, int sq, int color) {
+    const PortalSystem& portals = board.portals;
+    if (!portals.isExposed(sq, color)) return false;
+
+    // Girişe inen taş sq çıkışına atlar
+    for (int p = portals.firstAtExit(sq); p >= 0; p = portals.nextAtExit(p)) {
+        int entry = portals.entrySquare(p);
+        if (board.findPortalHop(entry, color) != p) continue;
+        Board::PieceCode code = board.codeAt(entry);
+        if (code != Board::EMPTY) {
+            if (Board::colorOf(code) != color && board.attackersOf(entry, color) > 0) return true;
+            continue;
+        }
+        for (int from : board.piecesOf(color == Board::WHITE)) {
+            if (generatePieceMoves(board, from, [&](int, int t, std::uint32_t flags) {
+                    return t == entry && !(flags & Move::PORTAL);
+                })) {
+                return true;
+            }
+        }
+    }
+
+    if (!portals.hasContinuations()) return false;
+
+    // Yön koruyan bir çıkıştan sq'ya boş bir doğru üzerinden devam eden kayan taş
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        int back = oppositeDirection(d);
+        int distance = 0;
+        for (int x = board.squareX(sq) + DIRECTION_DX[back], y = board.squareY(sq) + DIRECTION_DY[back];
+             board.isSquareValid(x, y); x += DIRECTION_DX[back], y += DIRECTION_DY[back]) {
+            int exit = board.squareIndex(x, y);
+            ++distance;
+            if (board.codeAt(exit) != Board::EMPTY) break;
+
+            for (int p = portals.firstAtExit(exit); p >= 0; p = portals.nextAtExit(p)) {
+                if (!portals.preservesDirection(p)) continue;
+                int entry = portals.entrySquare(p);
+                if (board.codeAt(entry) != Board::EMPTY || board.findPortalHop(entry, color) != p) continue;
+
+                // Girişin gerisinde d yönünde gelen ilk taş
+                int steps = 0;
+                int from = board.firstOccupied(entry, back, steps);
+                if (from < 0 || Board::colorOf(board.codeAt(from)) != color) continue;
+                const auto& ray = board.movementOf(board.codeAt(from)).ray(from, d);
+                if (ray.length() >= steps && ray.captureReach >= steps + distance) return true;
+            }
+        }
+    }
+    return false;
+}
+
+struct Pin {
+    int pinned;
+    int pinner;
+};
+
+// Bir taraf için şah ve açmaz bilgisi
+struct KingSafety {
+    int king = -1;
+    int enemy = Board::BLACK;
+    bool fallback = false;
+    int checkerCount = 0;
+    int checker = -1;
+    bool sliderCheck = false;
+    int pinCount = 0;
+    Pin pins[DIRECTION_COUNT];
+
+    KingSafety(const Board& board, bool isWhite) {
+        enemy = isWhite ? Board::BLACK : Board::WHITE;
+        const auto& royals = board.royalsOf(isWhite);
+        if (royals.size() > 1) {
+            // Birden fazla royal taş: hamleyi oynayarak doğrula
+            fallback = true;
+            return;
+        }
+        if (royals.empty()) return;
+        king = royals[0];
+
+        // Portal üzerinden saldırıya açık kral: açmaz ve şah maskeleri portalları görmez
+        if (board.portals.isExposed(king, enemy)) {
+            fallback = true;
+            return;
+        }
+
+        checkerCount = board.attackersOf(king, enemy);
+        if (checkerCount == 1) {
+            for (int sq : board.piecesOf(!isWhite)) {
+                if (attacks(board, sq, king, -1)) {
+                    checker = sq;
+                    sliderCheck = directionBetween(board.squareX(king) - board.squareX(sq),
+                                                   board.squareY(king) - board.squareY(sq)) >= 0 &&
+                                  chebyshev(board, sq, king) > 1;
+                    break;
                 }
             }
         }
+
+        // Her yönde kraldan sonraki ilk iki taş: kendi taşı ve arkasında onu açmaza alan rakip
+        int color = isWhite ? Board::WHITE : Board::BLACK;
+        for (int d = 0; d < DIRECTION_COUNT; ++d) {
+            int distance = 0;
+            int candidate = board.firstOccupied(king, d, distance);
+            if (candidate < 0 || Board::colorOf(board.codeAt(candidate)) != color) continue;
+            int sq = board.firstOccupied(candidate, d, distance);
+            if (sq >= 0 && Board::colorOf(board.codeAt(sq)) != color &&
+                reaches(board, sq, oppositeDirection(d), chebyshev(board, sq, king))) {
+                pins[pinCount++] = {candidate, sq};
+            }
+        }
     }
 
-    return true;
+    bool isLegal(Board& board, bool isWhite, int from, int to, std::uint32_t flags) const {
+        // Birden fazla kral, portala giren hamle ya da portalın gördüğü kareye giden kral:
+        // yerinde oynayıp dene
+        if (fallback || (flags & Move::PORTAL) || board.isPortalEntry(to) ||
+            (from == king && board.portals.isExposed(to, enemy))) {
+            Board::UndoRecord undo;
+            board.makeMove(Move(from, to, flags), undo);
+            bool legal = !Rules::isCheck(board, isWhite);
+            board.unmakeMove(undo);
+            return legal;
+        }
+        if (king == -1) return true;
+
+        if (from == king) {
+            return board.attackersOf(to, enemy) == 0 && !attackedThroughKing(board, king, to, enemy);
+        }
+
+        if (checkerCount >= 2) return false;
+        if (checkerCount == 1 && to != checker &&
+            !(sliderCheck && isStrictlyBetween(board, king, checker, to))) {
+            return false;
+        }
+
+        for (int i = 0; i < pinCount; ++i) {
+            if (pins[i].pinned == from) {
+                return to == pins[i].pinner || isStrictlyBetween(board, king, pins[i].pinner, to);
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+bool Rules::isCheck(const Board& board, bool isWhiteTurn) {
+    int enemy = isWhiteTurn ? Board::BLACK : Board::WHITE;
+    for (int sq : board.royalsOf(isWhiteTurn)) {
+        if (board.attackersOf(sq, enemy) > 0 || attackedThroughPortal(board, sq, enemy)) return true;
+    }
+    return false;
+}
+
+bool Rules::isSquareAttacked(const Board& board, int sq, bool byWhite, int ignoreSq, int skipSq) {
+    int color = byWhite ? Board::WHITE : Board::BLACK;
+    if (ignoreSq < 0 && skipSq < 0) {
+        return board.attackersOf(sq, color) > 0 || attackedThroughPortal(board, sq, color);
+    }
+    if (board.usesStandardKernel()) {
+        std::uint64_t occupied = board.kernelBitboards().occupied.words[0];
+        if (ignoreSq >= 0) occupied &= ~StandardKernel::bit(ignoreSq);
+        std::uint64_t attackers = board.kernelAttackers(sq, color, occupied);
+        if (skipSq >= 0) attackers &= ~StandardKernel::bit(skipSq);
+        return attackers != 0;
+    }
+    for (int from : board.piecesOf(byWhite)) {
+        if (from != skipSq && attacks(board, from, sq, ignoreSq)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Rules::isCheckmate(Board& board, bool isWhiteTurn) {
+    return isCheck(board, isWhiteTurn) && !hasAnyLegalMove(board, isWhiteTurn);
+}
+
+void Rules::generatePseudoLegalMoves(const Board& board, bool isWhiteTurn, MoveList& moves) {
+    for (int from : board.piecesOf(isWhiteTurn)) {
+        generatePieceMoves(board, from, [&](int f, int t, std::uint32_t flags) {
+            moves.push(Move(f, t, flags));
+            return false;
+        });
+    }
+}
+
+void Rules::generateLegalMoves(Board& board, bool isWhiteTurn, MoveList& moves) {
+    KingSafety safety(board, isWhiteTurn);
+    for (int from : board.piecesOf(isWhiteTurn)) {
+        generatePieceMoves(board, from, [&](int f, int t, std::uint32_t flags) {
+            if (safety.isLegal(board, isWhiteTurn, f, t, flags)) {
+                moves.push(Move(f, t, flags));
+            }
+            return false;
+        });
+    }
+}
+
+bool Rules::hasAnyLegalMove(Board& board, bool isWhiteTurn) {
+    KingSafety safety(board, isWhiteTurn);
+    for (int from : board.piecesOf(isWhiteTurn)) {
+        bool found = generatePieceMoves(board, from, [&](int f, int t, std::uint32_t flags) {
+            return safety.isLegal(board, isWhiteTurn, f, t, flags);
+        });
+        if (found) return true;
+    }
+    return false;
+}
+
+std::vector<std::pair<int, int>> Rules::getReachablePositions(Board& board, int x, int y) {
+    std::vector<std::pair<int, int>> positions;
+    if (!board.isSquareValid(x, y) || !board.hasPieceAt(x, y)) return positions;
+
+    int from = board.squareIndex(x, y);
+    bool isWhite = !Board::isBlackCode(board.codeAt(from));
+    KingSafety safety(board, isWhite);
+    generatePieceMoves(board, from, [&](int f, int t, std::uint32_t flags) {
+        if (safety.isLegal(board, isWhite, f, t, flags)) {
+            positions.emplace_back(board.squareX(t), board.squareY(t));
+        }
+        return false;
+    });
+    return positions;
 }
 
 bool Rules::canCastle(const Board& board, int kingX, int kingY, bool isLeft) {
     int rookX = isLeft ? 0 : board.board_size - 1;
-    auto king = board.getPiece(board.getKey(kingX, kingY));
-    auto rook = board.getPiece(board.getKey(rookX, kingY));
+    Board::PieceCode king = board.codeAt(board.squareIndex(kingX, kingY));
+    Board::PieceCode rook = board.codeAt(board.squareIndex(rookX, kingY));
+
+    if (king == Board::EMPTY || rook == Board::EMPTY || Board::colorOf(king) != Board::colorOf(rook)) {
+        return false;
+    }
 
-    if (!king || !rook || king->type != "King" || rook->type != "Rook") {
+    // Rok yapan iki taş da oynamamış olmalı; kale royal olmayan, rok yetenekli taştır
+    const PieceType &kingType = board.pieceType(king);
+    const PieceType &rookType = board.pieceType(rook);
+    if (!kingType.has(PieceRegistry::ROYAL) || !kingType.has(PieceRegistry::CASTLING) ||
+        !rookType.has(PieceRegistry::CASTLING) || rookType.has(PieceRegistry::ROYAL) ||
+        Board::hasMoved(king) || Board::hasMoved(rook)) {
         return false;
     }
+    bool isWhite = !Board::isBlackCode(king);
 
     int xStart = std::min(kingX, rookX) + 1;
     int xEnd = std::max(kingX, rookX);
-    for (int x = xStart; x < xEnd; ++x) {
-        if (board.hasPieceAt(board.getKey(x, kingY))) {
-            return false;
-        }
+    if (!isPathClear(board, kingX, kingY, rookX, kingY)) {
+        return false;
     }
 
-    if (isCheck(board, king->getIsWhite())) {
+    if (isCheck(board, isWhite)) {
         return false;
     }
 
+    int kingSquare = board.squareIndex(kingX, kingY);
     for (int x = xStart; x <= xEnd; ++x) {
-        Board testBoard = board.clone();
-        testBoard.movePiece(kingX, kingY, x, kingY);
-        if (isCheck(testBoard, king->getIsWhite())) {
+        int sq = board.squareIndex(x, kingY);
+        if (isSquareAttacked(board, sq, !isWhite, kingSquare, sq)) {
             return false;
         }
     }
@@ -92,74 +440,65 @@ bool Rules::canCastle(const Board& board, int kingX, int kingY, bool isLeft) {
 
 bool Rules::isValidMove(const Board& board, int x1, int y1, int x2, int y2) {
     if (x1 == x2 && y1 == y2) return false;
+    if (!board.isSquareValid(x1, y1) || !board.isSquareValid(x2, y2)) return false;
 
-    auto piece = board.getPiece(board.getKey(x1, y1));
-    if (!piece) return false;
+    int from = board.squareIndex(x1, y1);
+    int to = board.squareIndex(x2, y2);
+    if (board.codeAt(from) == Board::EMPTY) return false;
 
-    const auto& rules = piece->getMovementRules();
-    int dx = abs(x2 - x1);
-    int dy = abs(y2 - y1);
+    return !findMove(board, from, to).isNone();
+}
 
-    auto targetPiece = board.getPiece(board.getKey(x2, y2));
-    if (targetPiece && targetPiece->getIsWhite() == piece->getIsWhite()) {
-        return false;
-    }
+Move Rules::findMove(const Board& board, int from, int to, bool viaPortal) {
+    Move found;
+    if (from == to || board.codeAt(from) == Board::EMPTY) return found;
 
-    if (rules.l_shape && ((dx == 2 && dy == 1) || (dx == 1 && dy == 2))) {
+    // Derlenmiş hareket tablosunda bu hedefe giden ilk hamle; doğrudan hamleler önce üretilir
+    generatePieceMoves(board, from, [&](int f, int t, std::uint32_t flags) {
+        if (t != to || (viaPortal && !(flags & Move::PORTAL))) return false;
+        found = Move(f, t, flags);
         return true;
-    }
-
-    if (rules.diagonal && dx == dy) {
-        int xStep = (x2 > x1) ? 1 : -1;
-        int yStep = (y2 > y1) ? 1 : -1;
-        for (int i = 1; i < dx; ++i) {
-            if (board.hasPieceAt(board.getKey(x1 + i * xStep, y1 + i * yStep))) {
-                return false;
-            }
-        }
-        return true;
-    }
+    });
+    return found;
+}
 
-    if (piece->type != "Pawn" && rules.forward && dx == 0) {
-        int yStep = (y2 > y1) ? 1 : -1;
-        for (int y = y1 + yStep; y != y2; y += yStep) {
-            if (board.hasPieceAt(board.getKey(x1, y))) {
-                return false;
-            }
-        }
-        return true;
-    }
+bool Rules::leavesRoyalInCheck(Board& board, Move move) {
+    bool isWhite = !Board::isBlackCode(board.codeAt(move.from()));
+    Board::UndoRecord undo;
+    board.makeMove(move, undo);
+    bool exposed = isCheck(board, isWhite);
+    board.unmakeMove(undo);
+    return exposed;
+}
 
-    if (rules.sideways && dy == 0) {
-        int xStep = (x2 > x1) ? 1 : -1;
-        for (int x = x1 + xStep; x != x2; x += xStep) {
-            if (board.hasPieceAt(board.getKey(x, y1))) {
-                return false;
-            }
-        }
-        return true;
+Move Rules::findLegalMove(Board& board, int from, int to, bool viaPortal, MoveError* error) {
+    MoveError reason = MoveError::NONE;
+    Move move;
+    Board::PieceCode code = board.codeAt(from);
+    if (code == Board::EMPTY) {
+        reason = MoveError::NO_PIECE;
+    } else if (Board::isBlackCode(code) == board.whiteToMove) {
+        reason = MoveError::WRONG_SIDE;
+    } else if ((move = findMove(board, from, to, viaPortal)).isNone()) {
+        reason = MoveError::NOT_A_MOVE;
+    } else if (leavesRoyalInCheck(board, move)) {
+        reason = MoveError::LEAVES_ROYAL_IN_CHECK;
+        move = Move();
     }
+    if (error) *error = reason;
+    return move;
+}
 
-    if (piece->type == "Pawn" && rules.forward) {
-        bool isMovingForward = piece->getIsWhite() ? (y2 > y1) : (y2 < y1);
-
-        if (isMovingForward && dx == 0 && dy == 1 && !board.hasPieceAt(board.getKey(x2, y2))) {
-            return true;
-        }
-
-        if (rules.first_move_forward && isMovingForward && dx == 0 && dy == 2) {
-            bool isFirstMove = (piece->getIsWhite() && y1 == 1) || (!piece->getIsWhite() && y1 == board.board_size - 2);
-            int yStep = piece->getIsWhite() ? 1 : -1;
-            if (isFirstMove && !board.hasPieceAt(board.getKey(x1, y1 + yStep)) &&
-                !board.hasPieceAt(board.getKey(x2, y2))) {
-                return true;
-            }
-        }
+bool Rules::isPathClear(const Board& board, int x1, int y1, int x2, int y2) {
+    return board.isPathClear(board.squareIndex(x1, y1), board.squareIndex(x2, y2));
+}
 
-        if (rules.diagonal_capture && dx == 1 && dy == 1 && targetPiece && targetPiece->getIsWhite() != piece->getIsWhite()) {
-            return true;
-        }
+bool Rules::isMoveBlocked(const Board& board, int x1, int y1, int x2, int y2) {
+    Board::PieceCode mover = board.codeAt(board.squareIndex(x1, y1));
+    Board::PieceCode target = board.codeAt(board.squareIndex(x2, y2));
+    if (mover != Board::EMPTY && target != Board::EMPTY &&
+        Board::colorOf(mover) == Board::colorOf(target)) {
+        return true;
     }
-
-    return false;
+    return !isPathClear(board, x1, y1, x2, y2);
 }
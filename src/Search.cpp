@@ -0,0 +1,362 @@
+#include "Search.hpp"
+#include "Notation.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+int scoreToTT(int score, int ply) {
+    if (score > Search::MATE - Search::MAX_PLY) return score + ply;
+    if (score < -Search::MATE + Search::MAX_PLY) return score - ply;
+    return score;
+}
+
+int scoreFromTT(int score, int ply) {
+    if (score > Search::MATE - Search::MAX_PLY) return score - ply;
+    if (score < -Search::MATE + Search::MAX_PLY) return score + ply;
+    return score;
+}
+
+// Düğümden çıkarken anahtar yığınını geri sar
+struct KeyGuard {
+    std::vector<std::uint64_t> &stack;
+    KeyGuard(std::vector<std::uint64_t> &s, std::uint64_t key) : stack(s) { stack.push_back(key); }
+    ~KeyGuard() { stack.pop_back(); }
+};
+
+} // namespace
+
+Search::Search(TranspositionTable &tt) : tt(tt) {}
+
+SearchResult Search::think(Board &board, const SearchLimits &searchLimits, std::ostream *info) {
+    limits = searchLimits;
+    startTime = std::chrono::steady_clock::now();
+    stopFlag.store(false, std::memory_order_relaxed);
+    stopSignal = &stopFlag;
+    threadId = 0;
+    tt.newSearch();
+    prepare(board);
+
+    MoveList rootMoves;
+    Rules::generateLegalMoves(board, board.whiteToMove, rootMoves);
+    if (rootMoves.empty()) {
+        return SearchResult();
+    }
+
+    // Yardımcılar ana arama başlamadan tahtanın kendi kopyalarını alır
+    helpers.clear();
+    std::vector<std::thread> workers;
+    for (int i = 1; i < limits.threads; ++i) {
+        auto helper = std::make_unique<Search>(tt);
+        helper->limits = limits;
+        helper->startTime = startTime;
+        helper->gameHistory = gameHistory;
+        helper->tablebase = tablebase;
+        helper->stopSignal = &stopFlag;
+        helper->threadId = i;
+        helper->prepare(board);
+
+        Search *worker = helper.get();
+        workers.emplace_back([worker, copy = board, first = rootMoves[0]]() mutable {
+            worker->iterate(copy, first, nullptr);
+        });
+        helpers.push_back(std::move(helper));
+    }
+
+    SearchResult result = iterate(board, rootMoves[0], info);
+
+    stopFlag.store(true, std::memory_order_relaxed);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    result.nodes = totalNodes();
+    result.seconds = elapsedSeconds();
+    helpers.clear();
+    return result;
+}
+
+void Search::prepare(const Board &board) {
+    nodes = 0;
+    publishedNodes.store(0, std::memory_order_relaxed);
+    stopped = false;
+
+    for (auto &pair : killers) {
+        pair[0] = Move();
+        pair[1] = Move();
+    }
+    historyScores.assign(2 * static_cast<size_t>(board.board_size) * board.board_size, 0);
+    keyStack = gameHistory;
+
+    hadRoyal[Board::WHITE] = !board.royalsOf(true).empty();
+    hadRoyal[Board::BLACK] = !board.royalsOf(false).empty();
+}
+
+SearchResult Search::iterate(Board &board, Move firstMove, std::ostream *info) {
+    SearchResult result;
+    result.bestMove = firstMove;
+
+    // Yardımcıların yarısı bir derinlik önden başlar; böylece farklı ağaçları doldururlar
+    Evaluation eval(board);
+    for (int depth = 1 + (threadId & 1); depth <= limits.maxDepth && depth < MAX_PLY; ++depth) {
+        rootBest = Move();
+        int score = negamax(board, eval, depth, -INF, INF, 0);
+
+        // Yarıda kalan iterasyonun sonucu kullanılmaz
+        if (stopped) break;
+
+        result.bestMove = rootBest.isNone() ? result.bestMove : rootBest;
+        result.score = score;
+        result.depth = depth;
+        result.seconds = elapsedSeconds();
+        publishedNodes.store(nodes, std::memory_order_relaxed);
+
+        if (threadId != 0) continue;
+
+        result.nodes = totalNodes();
+        if (info) {
+            *info << "info depth " << depth << " score ";
+            if (isMateScore(score)) {
+                int matePly = MATE - std::abs(score);
+                *info << "mate " << (score > 0 ? (matePly + 1) / 2 : -(matePly / 2));
+            } else {
+                *info << "cp " << score;
+            }
+            *info << " nodes " << result.nodes << " nps "
+                  << static_cast<std::uint64_t>(result.seconds > 0 ? result.nodes / result.seconds : 0) << " time "
+                  << static_cast<int>(result.seconds * 1000) << " pv " << Notation::moveToString(board, result.bestMove)
+                  << "\n";
+        }
+
+        if (isMateScore(score) && MATE - std::abs(score) <= depth) break;
+        if (limits.moveTimeMs > 0 && result.seconds * 1000 * 2 > limits.moveTimeMs) break;
+    }
+
+    publishedNodes.store(nodes, std::memory_order_relaxed);
+    return result;
+}
+
+std::uint64_t Search::totalNodes() const {
+    std::uint64_t total = nodes;
+    for (const auto &helper : helpers) {
+        total += helper->publishedNodes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+int Search::negamax(Board &board, const Evaluation &eval, int depth, int alpha, int beta, int ply) {
+    if ((++nodes & 1023) == 0) checkLimits();
+    if (stopped) return 0;
+
+    if (royalLost(board)) return -MATE + ply;
+    if (ply > 0 && isRepetition(board.key())) return 0;
+    if (ply >= MAX_PLY - 1) return eval.evaluate(board);
+
+    // Tablodaki konumun değeri kesin; alt ağaç aranmaz
+    Tablebase::Result known;
+    if (ply > 0 && tablebase && tablebase->probe(board, known)) return tablebaseScore(known, ply);
+
+    bool white = board.whiteToMove;
+    bool inCheck = Rules::isCheck(board, white);
+    if (inCheck) ++depth;
+    if (depth <= 0) return quiescence(board, eval, alpha, beta, ply);
+
+    KeyGuard guard(keyStack, board.key());
+
+    std::uint32_t ttMove = 0;
+    TTEntry entry;
+    if (tt.probe(board.key(), entry)) {
+        ttMove = entry.move;
+        if (ply > 0 && entry.depth >= depth) {
+            int ttScore = scoreFromTT(entry.score, ply);
+            if (entry.bound() == Bound::EXACT ||
+                (entry.bound() == Bound::LOWER && ttScore >= beta) ||
+                (entry.bound() == Bound::UPPER && ttScore <= alpha)) {
+                return ttScore;
+            }
+        }
+    }
+
+    MoveList moves;
+    Rules::generateLegalMoves(board, white, moves);
+    if (moves.empty()) {
+        return inCheck ? -MATE + ply : 0;
+    }
+
+    int scoreBuffer[MoveList::CAPACITY];
+    std::vector<int> scoreSpill;
+    int *scores = scoreStorage(moves, scoreBuffer, scoreSpill);
+    scoreMoves(board, eval, moves, ttMove, ply, scores);
+
+    int originalAlpha = alpha;
+    int best = -INF;
+    Move bestMove;
+    Board::UndoRecord undo;
+
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        pickNext(moves, scores, i);
+        Move move = moves[i];
+
+        board.makeMove(move, undo);
+        int score;
+        if (i == 0) {
+            score = -negamax(board, eval, depth - 1, -beta, -alpha, ply + 1);
+        } else {
+            score = -negamax(board, eval, depth - 1, -alpha - 1, -alpha, ply + 1);
+            if (score > alpha && score < beta) {
+                score = -negamax(board, eval, depth - 1, -beta, -alpha, ply + 1);
+            }
+        }
+        board.unmakeMove(undo);
+
+        if (stopped) return 0;
+
+        if (score > best) {
+            best = score;
+            bestMove = move;
+            if (ply == 0) rootBest = move;
+        }
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            if (!move.isCapture() && ply < MAX_PLY) {
+                if (killers[ply][0] != move) {
+                    killers[ply][1] = killers[ply][0];
+                    killers[ply][0] = move;
+                }
+                int color = white ? Board::WHITE : Board::BLACK;
+                historyScores[color * board.board_size * board.board_size + move.to()] += depth * depth;
+            }
+            break;
+        }
+    }
+
+    Bound bound = best <= originalAlpha ? Bound::UPPER : best >= beta ? Bound::LOWER : Bound::EXACT;
+    tt.store(board.key(), bestMove, scoreToTT(best, ply), depth, bound);
+    return best;
+}
+
+int Search::quiescence(Board &board, const Evaluation &eval, int alpha, int beta, int ply) {
+    if ((++nodes & 1023) == 0) checkLimits();
+    if (stopped) return 0;
+
+    if (royalLost(board)) return -MATE + ply;
+
+    // Almalarla tabloya inen konumlar
+    Tablebase::Result known;
+    if (tablebase && tablebase->probe(board, known)) return tablebaseScore(known, ply);
+
+    int standPat = eval.evaluate(board);
+    if (ply >= MAX_PLY - 1) return standPat;
+    if (standPat >= beta) return standPat;
+    if (standPat > alpha) alpha = standPat;
+
+    MoveList moves;
+    Rules::generateLegalMoves(board, board.whiteToMove, moves);
+
+    MoveList captures;
+    for (Move move : moves) {
+        if (move.isCapture()) captures.push(move);
+    }
+
+    int scoreBuffer[MoveList::CAPACITY];
+    std::vector<int> scoreSpill;
+    int *scores = scoreStorage(captures, scoreBuffer, scoreSpill);
+    scoreMoves(board, eval, captures, 0, ply, scores);
+
+    int best = standPat;
+    Board::UndoRecord undo;
+    for (std::size_t i = 0; i < captures.size(); ++i) {
+        pickNext(captures, scores, i);
+        board.makeMove(captures[i], undo);
+        int score = -quiescence(board, eval, -beta, -alpha, ply + 1);
+        board.unmakeMove(undo);
+
+        if (stopped) return 0;
+
+        if (score > best) best = score;
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;
+    }
+    return best;
+}
+
+void Search::scoreMoves(const Board &board, const Evaluation &eval, const MoveList &moves,
+                        std::uint32_t ttMove, int ply, int *scores) const {
+    int color = board.whiteToMove ? Board::WHITE : Board::BLACK;
+    int squareCount = board.board_size * board.board_size;
+
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        Move move = moves[i];
+        if (ttMove != 0 && move.compact() == ttMove) {
+            scores[i] = 1 << 30;
+        } else if (move.isCapture()) {
+            // MVV-LVA: değerli taşı ucuz taşla almak önce
+            Board::PieceCode victimCode = board.victimOf(move);
+            int victim = board.isRoyal(victimCode) ? 100000 : eval.typeValue(board.typeOf(victimCode));
+            scores[i] = (1 << 24) + victim * 16 - eval.pieceValue(board, move.from()) / 16;
+        } else if (ply < MAX_PLY && (move == killers[ply][0] || move == killers[ply][1])) {
+            scores[i] = (1 << 23) + (move == killers[ply][0] ? 1 : 0);
+        } else {
+            scores[i] = std::min(historyScores[color * squareCount + move.to()], (1 << 22));
+        }
+    }
+}
+
+int *Search::scoreStorage(const MoveList &moves, int *buffer, std::vector<int> &spill) {
+    if (moves.size() <= MoveList::CAPACITY) return buffer;
+    spill.resize(moves.size());
+    return spill.data();
+}
+
+void Search::pickNext(MoveList &moves, int *scores, std::size_t index) {
+    std::size_t best = index;
+    for (std::size_t j = index + 1; j < moves.size(); ++j) {
+        if (scores[j] > scores[best]) best = j;
+    }
+    if (best != index) {
+        std::swap(moves[index], moves[best]);
+        std::swap(scores[index], scores[best]);
+    }
+}
+
+int Search::tablebaseScore(const Tablebase::Result &known, int ply) {
+    if (known.wdl == Tablebase::Wdl::DRAW) return 0;
+    int distance = known.dtm >= 0 ? std::min(ply + known.dtm, MAX_PLY) : MAX_PLY;
+    return known.wdl == Tablebase::Wdl::WIN ? MATE - distance : -MATE + distance;
+}
+
+bool Search::royalLost(const Board &board) const {
+    int color = board.whiteToMove ? Board::WHITE : Board::BLACK;
+    return hadRoyal[color] && board.royalsOf(board.whiteToMove).empty();
+}
+
+bool Search::isRepetition(std::uint64_t key) const {
+    for (std::size_t i = keyStack.size(); i-- > 0;) {
+        if (keyStack[i] == key) return true;
+    }
+    return false;
+}
+
+void Search::checkLimits() {
+    publishedNodes.store(nodes, std::memory_order_relaxed);
+
+    // Sınırları yalnızca ana arama denetler; yardımcılar onun bayrağını izler
+    if (threadId == 0) {
+        if ((limits.maxNodes > 0 && totalNodes() >= limits.maxNodes) ||
+            (limits.moveTimeMs > 0 && elapsedSeconds() * 1000 >= limits.moveTimeMs)) {
+            stopSignal->store(true, std::memory_order_relaxed);
+        }
+    }
+    if (stopSignal->load(std::memory_order_relaxed)) {
+        stopped = true;
+    }
+}
+
+double Search::elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
@@ -0,0 +1,35 @@
+#include "StandardKernel.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// 8x8 tahtada 7 ve üzeri menzil sınırsız kaymayla aynıdır
+int range(int value) {
+    return std::min(value, StandardKernel::SIZE - 1);
+}
+
+bool sameMovement(const Movement &movement, int forward, int sideways, int diagonal, bool lShape,
+                  int diagonalCapture, int firstMove) {
+    return range(movement.forward) == forward && range(movement.sideways) == sideways &&
+           range(movement.diagonal) == diagonal && movement.l_shape == lShape &&
+           range(movement.diagonal_capture) == diagonalCapture && range(movement.first_move_forward) == firstMove;
+}
+
+} // namespace
+
+StandardKernel::Kind StandardKernel::kindOf(const PieceConfig &piece) {
+    const auto &m = piece.movement;
+    if (piece.type == "King" && sameMovement(m, 1, 1, 1, false, 0, 0)) return KING;
+    if (piece.type == "Queen" && sameMovement(m, 7, 7, 7, false, 0, 0) && !piece.special_abilities.royal) return QUEEN;
+    if (piece.type == "Rook" && sameMovement(m, 7, 7, 0, false, 0, 0) && !piece.special_abilities.royal) return ROOK;
+    if (piece.type == "Bishop" && sameMovement(m, 0, 0, 7, false, 0, 0) && !piece.special_abilities.royal) return BISHOP;
+    if (piece.type == "Knight" && sameMovement(m, 0, 0, 0, true, 0, 0) && !piece.special_abilities.royal) return KNIGHT;
+    if (piece.type == "Pawn" && sameMovement(m, 1, 0, 0, false, 1, 2) && !piece.special_abilities.royal) return PAWN;
+    return NONE;
+}
+
+bool StandardKernel::matches(const std::vector<PieceConfig> &pieces, int boardSize) {
+    if (boardSize != SIZE) return false;
+    return std::all_of(pieces.begin(), pieces.end(), [](const PieceConfig &piece) { return kindOf(piece) != NONE; });
+}
@@ -0,0 +1,857 @@
+#include "Tablebase.hpp"
+#include "GameRecord.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+const char MAGIC[4] = {'C', 'T', 'B', 'L'};
+
+constexpr std::uint16_t FLAG_DTM = 1;
+
+// Konum başına 2 bit
+constexpr std::uint8_t CODE_DRAW = 0;
+constexpr std::uint8_t CODE_WIN = 1;
+constexpr std::uint8_t CODE_LOSS = 2;
+constexpr std::uint8_t CODE_INVALID = 3;
+
+// Diskte mesafe bir bayt; daha uzun (ya da bilinmeyen) mesafeler bu değerle yazılır
+constexpr int DTM_UNKNOWN = 255;
+
+// Bir iş parçacığının aynı anda aldığı konum sayısı
+constexpr std::uint64_t POSITIONS_PER_CHUNK = 4096;
+
+using PieceCode = Board::PieceCode;
+
+PieceCode pieceOf(PieceCode code) {
+    return static_cast<PieceCode>(code & ~Board::MOVED_BIT);
+}
+
+// Tahtadaki taşların (oynadı biti olmadan) sıralı kodları
+int materialOf(const Board &board, PieceCode *codes, int capacity) {
+    int count = 0;
+    for (int color = 0; color < 2; ++color) {
+        for (int sq : board.pieceSquares[color]) {
+            if (count == capacity) return capacity + 1;
+            codes[count++] = pieceOf(board.codeAt(sq));
+        }
+    }
+    std::sort(codes, codes + count);
+    return count;
+}
+
+// Kareye 8 tahta simetrisinden birini uygula: bit 2 köşegen yansıması, bit 0 ve 1 yatay/dikey ayna
+int transformSquare(int transform, int sq, int size) {
+    int x = sq % size;
+    int y = sq / size;
+    if (transform & 4) std::swap(x, y);
+    if (transform & 1) x = size - 1 - x;
+    if (transform & 2) y = size - 1 - y;
+    return y * size + x;
+}
+
+struct RayShape {
+    std::vector<int> targets;
+    int moveLength;
+    int captureLength;
+    int doubleStepFrom;
+
+    bool operator<(const RayShape &other) const {
+        return std::tie(targets, moveLength, captureLength, doubleStepFrom) <
+               std::tie(other.targets, other.moveLength, other.captureLength, other.doubleStepFrom);
+    }
+    bool operator==(const RayShape &other) const {
+        return targets == other.targets && moveLength == other.moveLength && captureLength == other.captureLength &&
+               doubleStepFrom == other.doubleStepFrom;
+    }
+};
+
+// sq'dan çıkan ışınlar ve L hamleleri, kareleri perm ile eşlenmiş olarak
+void movesFrom(const MovementTable &table, int sq, const std::vector<int> &perm, std::vector<RayShape> &rays,
+               std::vector<int> &leaps) {
+    rays.clear();
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        const auto &ray = table.ray(sq, d);
+        if (ray.length() == 0) continue;
+        RayShape shape{{}, ray.moveLength, ray.captureLength, ray.doubleStepFrom};
+        for (int i = 0; i < ray.length(); ++i) {
+            shape.targets.push_back(perm[table.target(ray, i)]);
+        }
+        rays.push_back(std::move(shape));
+    }
+    std::sort(rays.begin(), rays.end());
+
+    leaps.clear();
+    for (const int *target = table.leapsBegin(sq); target != table.leapsEnd(sq); ++target) {
+        leaps.push_back(perm[*target]);
+    }
+    std::sort(leaps.begin(), leaps.end());
+}
+
+// Hareket tablosu simetriyle değişmiyor mu: her karenin eşlenmiş hamleleri eşlendiği karenin hamleleri
+bool isSymmetric(const MovementTable &table, const std::vector<int> &perm, const std::vector<int> &identity) {
+    std::vector<RayShape> mappedRays, rays;
+    std::vector<int> mappedLeaps, leaps;
+    for (int sq = 0; sq < static_cast<int>(perm.size()); ++sq) {
+        movesFrom(table, sq, perm, mappedRays, mappedLeaps);
+        movesFrom(table, perm[sq], identity, rays, leaps);
+        if (!(mappedRays == rays) || mappedLeaps != leaps) return false;
+    }
+    return true;
+}
+
+// Taraflardan birinin royal taşı ve onunla rok yapabilecek oynamamış bir taşı var mı
+bool mayCastle(const Board &board) {
+    for (int color = 0; color < 2; ++color) {
+        bool royal = false;
+        bool partner = false;
+        for (int sq : board.pieceSquares[color]) {
+            PieceCode code = board.codeAt(sq);
+            if (Board::hasMoved(code) || !board.pieceType(code).has(PieceRegistry::CASTLING)) continue;
+            (board.isRoyal(code) ? royal : partner) = true;
+        }
+        if (royal && partner) return true;
+    }
+    return false;
+}
+
+template <typename Work>
+void runParallel(int jobs, Work &&work) {
+    std::vector<std::thread> threads;
+    for (int t = 1; t < jobs; ++t) {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------
+// Konum numaralandırması
+
+Tablebase::Layout::Layout(const Board &start, std::vector<PieceCode> material)
+    : boardSize(start.board_size), squareCount(start.board_size * start.board_size), pieces(std::move(material)) {
+    for (auto &code : pieces) code = pieceOf(code);
+    std::sort(pieces.begin(), pieces.end());
+
+    for (int p = 0; p < start.portals.count(); ++p) {
+        bool onBoard = start.portals.entrySquare(p) >= 0;
+        cooldownRadix.push_back(onBoard ? std::max(0, start.portals.config(p).properties.cooldown) + 1 : 1);
+    }
+
+    std::vector<int> identity(squareCount);
+    for (int sq = 0; sq < squareCount; ++sq) identity[sq] = sq;
+    transforms.push_back(identity);
+
+    // Portallar tahtanın simetrisini bozar; taşların hepsi simetriye uymalı
+    if (start.portals.count() == 0) {
+        std::vector<PieceCode> distinct(pieces);
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        for (int t = 1; t < 8; ++t) {
+            std::vector<int> perm(squareCount);
+            for (int sq = 0; sq < squareCount; ++sq) perm[sq] = transformSquare(t, sq, boardSize);
+            bool symmetric = true;
+            for (PieceCode code : distinct) {
+                if (!isSymmetric(start.movementOf(code), perm, identity)) {
+                    symmetric = false;
+                    break;
+                }
+            }
+            if (symmetric) transforms.push_back(std::move(perm));
+        }
+    }
+
+    // İlk taşın karesi, yörüngesindeki en küçük kareye götüren ilk simetriyle indirgenir
+    domainIndex.assign(squareCount, -1);
+    toDomain.assign(squareCount, 0);
+    for (int sq = 0; sq < squareCount; ++sq) {
+        int best = 0;
+        for (int g = 1; g < static_cast<int>(transforms.size()); ++g) {
+            if (transforms[g][sq] < transforms[best][sq]) best = g;
+        }
+        toDomain[sq] = best;
+        if (best == 0) {
+            domainIndex[sq] = static_cast<int>(domainSquares.size());
+            domainSquares.push_back(sq);
+        }
+    }
+
+    positions = pieces.empty() ? 0 : domainSquares.size();
+    for (std::size_t i = 1; i < pieces.size(); ++i) positions *= static_cast<std::uint64_t>(squareCount);
+    for (int radix : cooldownRadix) positions *= static_cast<std::uint64_t>(radix);
+    positions *= 2;
+}
+
+bool Tablebase::Layout::index(const Board &board, std::uint64_t &out) const {
+    int count = static_cast<int>(pieces.size());
+    if (static_cast<int>(board.pieceSquares[0].size() + board.pieceSquares[1].size()) != count) return false;
+
+    std::array<std::pair<PieceCode, int>, MAX_PIECES> placed;
+    int n = 0;
+    for (int color = 0; color < 2; ++color) {
+        for (int sq : board.pieceSquares[color]) {
+            placed[n++] = {pieceOf(board.codeAt(sq)), sq};
+        }
+    }
+    std::sort(placed.begin(), placed.begin() + n);
+    for (int i = 0; i < n; ++i) {
+        if (placed[i].first != pieces[i]) return false;
+    }
+    if (mayCastle(board)) return false;
+
+    const auto &perm = transforms[toDomain[placed[0].second]];
+    std::uint64_t result = static_cast<std::uint64_t>(domainIndex[perm[placed[0].second]]);
+    for (int i = 1; i < n; ++i) {
+        result = result * squareCount + perm[placed[i].second];
+    }
+    for (int p = 0; p < static_cast<int>(cooldownRadix.size()); ++p) {
+        int remaining = std::clamp(board.portals.cooldownEnd(p) - board.ply, 0, cooldownRadix[p] - 1);
+        result = result * cooldownRadix[p] + remaining;
+    }
+    out = result * 2 + (board.whiteToMove ? 0 : 1);
+    return true;
+}
+
+bool Tablebase::Layout::setup(Board &board, std::uint64_t index) const {
+    bool white = (index & 1) == 0;
+    index >>= 1;
+
+    int count = static_cast<int>(cooldownRadix.size());
+    std::vector<int> remaining(count);
+    for (int p = count - 1; p >= 0; --p) {
+        remaining[p] = static_cast<int>(index % cooldownRadix[p]);
+        index /= cooldownRadix[p];
+    }
+
+    int n = static_cast<int>(pieces.size());
+    std::array<int, MAX_PIECES> squares;
+    for (int i = n - 1; i >= 1; --i) {
+        squares[i] = static_cast<int>(index % squareCount);
+        index /= squareCount;
+    }
+    squares[0] = domainSquares[index];
+    for (int i = 1; i < n; ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (squares[i] == squares[j]) return false;
+        }
+    }
+
+    for (int color = 0; color < 2; ++color) {
+        while (!board.pieceSquares[color].empty()) board.setPiece(board.pieceSquares[color].back(), Board::EMPTY);
+    }
+    for (int i = 0; i < n; ++i) {
+        board.setPiece(squares[i], pieces[i] | Board::MOVED_BIT);
+    }
+    for (int p = 0; p < count; ++p) {
+        board.setPortalCooldown(p, remaining[p]);
+    }
+    board.setSideToMove(white);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Diskteki tablo
+
+struct Tablebase::Table {
+    Layout layout;
+    MappedFile file;
+    const std::uint8_t *wdl = nullptr;
+    const std::uint8_t *dtm = nullptr;   // mesafe yazılmadıysa nullptr
+
+    Table(const Board &start, std::vector<PieceCode> material) : layout(start, std::move(material)) {}
+
+    // Numaralı konumun sonucu; geçersiz konumda false
+    bool value(std::uint64_t index, Result &result) const {
+        std::uint8_t code = (wdl[index >> 2] >> ((index & 3) * 2)) & 3;
+        if (code == CODE_INVALID) return false;
+        result.wdl = code == CODE_WIN ? Wdl::WIN : code == CODE_LOSS ? Wdl::LOSS : Wdl::DRAW;
+        result.dtm = -1;
+        if (code == CODE_DRAW) {
+            result.dtm = 0;
+        } else if (dtm && dtm[index] != DTM_UNKNOWN) {
+            result.dtm = dtm[index];
+        }
+        return true;
+    }
+
+    bool probe(const Board &board, Result &result) const {
+        std::uint64_t index;
+        return layout.index(board, index) && value(index, result);
+    }
+};
+
+namespace {
+
+std::size_t wdlBytes(std::uint64_t positions) {
+    return static_cast<std::size_t>((positions + 3) / 4 + 7) / 8 * 8;
+}
+
+std::unique_ptr<Tablebase::Table> openTable(const std::string &path, const Board &start, std::uint64_t variantHash,
+                                            std::string &error) {
+    MappedFile file;
+    if (!file.map(path, Tablebase::HEADER_SIZE, "a tablebase", error)) return nullptr;
+    const std::uint8_t *data = file.data();
+
+    std::uint16_t version, flags, boardSize, pieceCount, symmetries;
+    std::uint64_t hash, positions;
+    std::memcpy(&version, data + 4, sizeof(version));
+    std::memcpy(&flags, data + 6, sizeof(flags));
+    std::memcpy(&hash, data + 8, sizeof(hash));
+    std::memcpy(&positions, data + 16, sizeof(positions));
+    std::memcpy(&boardSize, data + 24, sizeof(boardSize));
+    std::memcpy(&pieceCount, data + 26, sizeof(pieceCount));
+    std::memcpy(&symmetries, data + 28, sizeof(symmetries));
+
+    auto reject = [&](const std::string &message) -> std::unique_ptr<Tablebase::Table> {
+        error = message;
+        return nullptr;
+    };
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || version != Tablebase::VERSION ||
+        pieceCount == 0 || pieceCount > Tablebase::MAX_PIECES) {
+        return reject(path + " is not a version " + std::to_string(Tablebase::VERSION) + " tablebase");
+    }
+    if (hash != variantHash || boardSize != start.board_size) {
+        return reject(path + " was built for a different variant");
+    }
+
+    std::vector<PieceCode> material(pieceCount);
+    std::memcpy(material.data(), data + 32, pieceCount * sizeof(PieceCode));
+    auto table = std::make_unique<Tablebase::Table>(start, material);
+    std::size_t expected = Tablebase::HEADER_SIZE + wdlBytes(positions) + ((flags & FLAG_DTM) ? positions : 0);
+    if (table->layout.size() != positions || table->layout.symmetries() != symmetries || file.size() < expected) {
+        return reject(path + " does not match this variant's layout");
+    }
+
+    table->wdl = data + Tablebase::HEADER_SIZE;
+    table->dtm = (flags & FLAG_DTM) ? table->wdl + wdlBytes(positions) : nullptr;
+    table->file = std::move(file);
+    return table;
+}
+
+// Bir malzemenin çözümü. Önce her konumun hamleleri üretilir: alma hamleleri zaten çözülmüş alt
+// tablolara bakılarak değerlendirilir, tablo içinde kalan hamleler için ters kenar listesi kurulur.
+// Ardından sonuçlar mat mesafesine göre katman katman geriye yayılır: kaybeden konumun tüm
+// öncülleri kazanır, kazanan konumun öncüllerinden son kaçış yolu da kapananlar kaybeder.
+class Solver {
+public:
+    static constexpr std::uint8_t UNKNOWN = 0;
+    static constexpr std::uint8_t PENDING_WIN = 1;
+    static constexpr std::uint8_t PENDING_LOSS = 2;
+    static constexpr std::uint8_t WIN = 3;
+    static constexpr std::uint8_t LOSS = 4;
+    static constexpr std::uint8_t DRAW = 5;
+    static constexpr std::uint8_t INVALID = 6;
+
+    static constexpr std::uint16_t NO_WIN = 0xFFFF;
+
+    Solver(const Board &start, const Tablebase::Layout &layout, const std::vector<const Tablebase::Table *> &subTables,
+           int jobs)
+        : start(start), layout(layout), subTables(subTables), jobs(std::max(jobs, 1)) {
+        for (PieceCode code : layout.material()) {
+            if (start.isRoyal(code)) hadRoyal[Board::colorOf(code)] = true;
+        }
+    }
+
+    bool solve(std::size_t memoryMb, std::string &error) {
+        std::uint64_t n = layout.size();
+        if (n >= 0xFFFFFFFFull) {
+            error = "too many positions";
+            return false;
+        }
+        status.assign(n, UNKNOWN);
+        remaining.assign(n, 0);
+        dtm.assign(n, 0);
+        lossFloor.assign(n, 0);
+        inDegree.assign(n + 1, 0);
+
+        scanMoves();
+        if (failed) {
+            error = "a capture leads to a position missing from the sub-tables";
+            return false;
+        }
+
+        // Ters kenarlar: preds[predStart[c], predStart[c + 1]) c'ye hamle yapan konumlar
+        std::uint64_t edges = 0;
+        predStart.assign(n + 1, 0);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            predStart[i] = edges;
+            edges += inDegree[i];
+        }
+        predStart[n] = edges;
+        std::uint64_t needMb = (edges * sizeof(std::uint32_t) + n * 16) >> 20;
+        if (needMb > memoryMb) {
+            error = "needs about " + std::to_string(needMb) + " MB (limit " + std::to_string(memoryMb) + " MB)";
+            return false;
+        }
+        preds.resize(edges);
+        std::fill(inDegree.begin(), inDegree.end(), 0);
+        fillPredecessors();
+        std::vector<std::uint32_t>().swap(inDegree);
+
+        propagate();
+        return true;
+    }
+
+    std::uint8_t code(std::uint64_t i) const {
+        switch (status[i]) {
+        case WIN: return CODE_WIN;
+        case LOSS: return CODE_LOSS;
+        case INVALID: return CODE_INVALID;
+        default: return CODE_DRAW;
+        }
+    }
+    int distance(std::uint64_t i) const { return dtm[i]; }
+    bool distancesKnown() const { return !unknownDistance; }
+
+private:
+    const Board &start;
+    const Tablebase::Layout &layout;
+    const std::vector<const Tablebase::Table *> &subTables;
+    int jobs;
+    bool hadRoyal[2] = {false, false};
+
+    std::vector<std::uint8_t> status;
+    std::vector<std::uint16_t> remaining;   // rakibin kazandığı bilinmeyen hamle sayısı
+    std::vector<std::uint16_t> dtm;         // sonuç kesinleşince mesafe; öncesinde almayla kazanç adayı
+    std::vector<std::uint16_t> lossFloor;   // kaybederse mesafe en az bu (rakibe kazandıran almalar)
+    std::vector<std::uint32_t> inDegree;
+    std::vector<std::uint64_t> predStart;
+    std::vector<std::uint32_t> preds;
+    std::vector<std::vector<std::uint32_t>> buckets;   // mesafe -> o katmanda kesinleşecek adaylar
+
+    std::atomic<bool> failed{false};
+    std::atomic<bool> unknownDistance{false};
+
+    // Hamleden sonraki konum: tablo içindeyse numarası, değilse (alma) değeri
+    bool classify(const Board &child, std::uint64_t &index, Tablebase::Result &result) {
+        if (layout.index(child, index)) return true;
+
+        int victim = child.whiteToMove ? Board::WHITE : Board::BLACK;
+        if (hadRoyal[victim] && child.royalsOf(child.whiteToMove).empty()) {
+            result = {Tablebase::Wdl::LOSS, 0};
+            return false;
+        }
+        PieceCode codes[Tablebase::MAX_PIECES + 1];
+        int count = materialOf(child, codes, Tablebase::MAX_PIECES);
+        for (const auto *table : subTables) {
+            const auto &material = table->layout.material();
+            if (static_cast<int>(material.size()) == count && std::equal(material.begin(), material.end(), codes) &&
+                table->probe(child, result)) {
+                if (result.wdl != Tablebase::Wdl::DRAW && result.dtm < 0) {
+                    unknownDistance = true;
+                    result.dtm = 0;
+                }
+                return false;
+            }
+        }
+        failed = true;
+        result = {Tablebase::Wdl::DRAW, 0};
+        return false;
+    }
+
+    template <typename Visit>
+    void forEachChunk(Visit &&visit) {
+        std::atomic<std::uint64_t> nextChunk{0};
+        std::uint64_t n = layout.size();
+        runParallel(jobs, [&](int id) {
+            Board board = start;
+            for (std::uint64_t c = nextChunk++; c * POSITIONS_PER_CHUNK < n; c = nextChunk++) {
+                std::uint64_t first = c * POSITIONS_PER_CHUNK;
+                visit(id, board, first, std::min(first + POSITIONS_PER_CHUNK, n));
+            }
+        });
+    }
+
+    void scanMoves() {
+        std::vector<std::vector<std::pair<std::uint16_t, std::uint32_t>>> seeds(static_cast<std::size_t>(jobs));
+
+        forEachChunk([&](int id, Board &board, std::uint64_t first, std::uint64_t last) {
+            MoveList moves;
+            Board::UndoRecord undo;
+            for (std::uint64_t i = first; i < last; ++i) {
+                bool white = (i & 1) == 0;
+                if (!layout.setup(board, i) || Rules::isCheck(board, !white)) {
+                    status[i] = INVALID;
+                    continue;
+                }
+
+                moves.clear();
+                Rules::generateLegalMoves(board, white, moves);
+                if (moves.empty()) {
+                    if (Rules::isCheck(board, white)) {
+                        status[i] = PENDING_LOSS;
+                        seeds[id].push_back({0, static_cast<std::uint32_t>(i)});
+                    } else {
+                        status[i] = DRAW;
+                    }
+                    continue;
+                }
+
+                int open = static_cast<int>(moves.size());
+                int captureWin = NO_WIN;
+                int floor = 0;
+                for (Move move : moves) {
+                    board.makeMove(move, undo);
+                    std::uint64_t child;
+                    Tablebase::Result result;
+                    if (classify(board, child, result)) {
+                        std::atomic_ref<std::uint32_t>(inDegree[child]).fetch_add(1, std::memory_order_relaxed);
+                    } else if (result.wdl == Tablebase::Wdl::LOSS) {
+                        captureWin = std::min(captureWin, result.dtm + 1);
+                    } else if (result.wdl == Tablebase::Wdl::WIN) {
+                        --open;
+                        floor = std::max(floor, result.dtm + 1);
+                    }
+                    board.unmakeMove(undo);
+                }
+
+                remaining[i] = static_cast<std::uint16_t>(open);
+                lossFloor[i] = static_cast<std::uint16_t>(floor);
+                if (open == 0) {
+                    status[i] = PENDING_LOSS;
+                    seeds[id].push_back({static_cast<std::uint16_t>(floor), static_cast<std::uint32_t>(i)});
+                } else if (captureWin != NO_WIN) {
+                    seeds[id].push_back({static_cast<std::uint16_t>(captureWin), static_cast<std::uint32_t>(i)});
+                }
+            }
+        });
+
+        for (const auto &list : seeds) addToBuckets(list);
+    }
+
+    void fillPredecessors() {
+        forEachChunk([&](int, Board &board, std::uint64_t first, std::uint64_t last) {
+            MoveList moves;
+            Board::UndoRecord undo;
+            for (std::uint64_t i = first; i < last; ++i) {
+                if (status[i] == INVALID || status[i] == DRAW || (status[i] == PENDING_LOSS && remaining[i] == 0)) {
+                    continue;
+                }
+                layout.setup(board, i);
+                moves.clear();
+                Rules::generateLegalMoves(board, board.whiteToMove, moves);
+                for (Move move : moves) {
+                    board.makeMove(move, undo);
+                    std::uint64_t child;
+                    Tablebase::Result result;
+                    if (classify(board, child, result)) {
+                        std::uint32_t slot =
+                            std::atomic_ref<std::uint32_t>(inDegree[child]).fetch_add(1, std::memory_order_relaxed);
+                        preds[predStart[child] + slot] = static_cast<std::uint32_t>(i);
+                    }
+                    board.unmakeMove(undo);
+                }
+            }
+        });
+    }
+
+    void addToBuckets(const std::vector<std::pair<std::uint16_t, std::uint32_t>> &list) {
+        for (const auto &[distance, index] : list) {
+            if (distance >= buckets.size()) buckets.resize(distance + 1);
+            buckets[distance].push_back(index);
+        }
+    }
+
+    static bool claim(std::uint8_t &cell, std::uint8_t from, std::uint8_t to) {
+        return std::atomic_ref<std::uint8_t>(cell).compare_exchange_strong(from, to, std::memory_order_relaxed);
+    }
+
+    // Katman d'deki adayları kesinleştir ve öncüllerine yay
+    void propagate() {
+        for (std::size_t d = 0; d < buckets.size(); ++d) {
+            std::vector<std::uint32_t> layer = std::move(buckets[d]);
+            std::vector<std::vector<std::pair<std::uint16_t, std::uint32_t>>> found(static_cast<std::size_t>(jobs));
+            std::atomic<std::size_t> nextChunk{0};
+            auto distance = static_cast<std::uint16_t>(std::min<std::size_t>(d, 0xFFFE));
+
+            runParallel(jobs, [&](int id) {
+                auto &out = found[id];
+                for (std::size_t c = nextChunk++; c * POSITIONS_PER_CHUNK < layer.size(); c = nextChunk++) {
+                    std::size_t end = std::min((c + 1) * POSITIONS_PER_CHUNK, layer.size());
+                    for (std::size_t k = c * POSITIONS_PER_CHUNK; k < end; ++k) {
+                        std::uint32_t p = layer[k];
+                        bool lost = claim(status[p], PENDING_LOSS, LOSS);
+                        if (!lost && !claim(status[p], PENDING_WIN, WIN) && !claim(status[p], UNKNOWN, WIN)) continue;
+                        dtm[p] = distance;
+
+                        for (std::uint64_t e = predStart[p]; e < predStart[p + 1]; ++e) {
+                            std::uint32_t q = preds[e];
+                            if (lost) {
+                                if (claim(status[q], UNKNOWN, PENDING_WIN)) out.push_back({distance + 1, q});
+                                continue;
+                            }
+                            auto left = std::atomic_ref<std::uint16_t>(remaining[q]).fetch_sub(1, std::memory_order_relaxed);
+                            if (left == 1 && claim(status[q], UNKNOWN, PENDING_LOSS)) {
+                                out.push_back({std::max<std::uint16_t>(lossFloor[q], distance + 1), q});
+                            }
+                        }
+                    }
+                }
+            });
+
+            for (const auto &list : found) addToBuckets(list);
+        }
+    }
+};
+
+bool writeTable(const std::string &path, const Board &start, std::uint64_t variantHash,
+                const Tablebase::Layout &layout, const Solver &solver, bool withDtm) {
+    std::uint64_t n = layout.size();
+    const auto &material = layout.material();
+
+    std::uint8_t header[Tablebase::HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    std::uint16_t version = Tablebase::VERSION;
+    std::uint16_t flags = withDtm ? FLAG_DTM : 0;
+    std::uint16_t boardSize = static_cast<std::uint16_t>(start.board_size);
+    std::uint16_t pieceCount = static_cast<std::uint16_t>(material.size());
+    std::uint16_t symmetries = static_cast<std::uint16_t>(layout.symmetries());
+    std::memcpy(header + 4, &version, sizeof(version));
+    std::memcpy(header + 6, &flags, sizeof(flags));
+    std::memcpy(header + 8, &variantHash, sizeof(variantHash));
+    std::memcpy(header + 16, &n, sizeof(n));
+    std::memcpy(header + 24, &boardSize, sizeof(boardSize));
+    std::memcpy(header + 26, &pieceCount, sizeof(pieceCount));
+    std::memcpy(header + 28, &symmetries, sizeof(symmetries));
+    std::memcpy(header + 32, material.data(), material.size() * sizeof(PieceCode));
+
+    std::vector<std::uint8_t> packed(wdlBytes(n), 0);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        packed[i >> 2] |= static_cast<std::uint8_t>(solver.code(i) << ((i & 3) * 2));
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(packed.data()), static_cast<std::streamsize>(packed.size()));
+    if (withDtm) {
+        std::vector<std::uint8_t> distances(n);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            std::uint8_t code = solver.code(i);
+            bool decided = code == CODE_WIN || code == CODE_LOSS;
+            distances[i] = static_cast<std::uint8_t>(decided ? std::min(solver.distance(i), DTM_UNKNOWN) : 0);
+        }
+        out.write(reinterpret_cast<const char *>(distances.data()), static_cast<std::streamsize>(n));
+    }
+    return out.good();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------
+// Üretim
+
+std::string Tablebase::fileName(const Board &start, const std::vector<PieceCode> &material) {
+    std::string sides[2];
+    for (PieceCode code : material) {
+        std::string &side = sides[Board::colorOf(code)];
+        if (!side.empty()) side += '+';
+        for (char c : start.pieceType(code).name) {
+            side += std::isalnum(static_cast<unsigned char>(c)) ? c : '-';
+        }
+    }
+    for (auto &side : sides) {
+        if (side.empty()) side = "none";
+    }
+    return sides[Board::WHITE] + "_vs_" + sides[Board::BLACK] + ".ctb";
+}
+
+bool Tablebase::build(const Board &start, std::uint64_t variantHash, std::vector<PieceCode> material,
+                      const std::string &directory, const BuildOptions &options, BuildStats &stats,
+                      std::string &error) {
+    stats = BuildStats();
+    for (auto &code : material) code = pieceOf(code);
+    std::sort(material.begin(), material.end());
+    if (material.empty() || material.size() > MAX_PIECES) {
+        error = "a tablebase needs between 1 and " + std::to_string(MAX_PIECES) + " pieces";
+        return false;
+    }
+    for (PieceCode code : material) {
+        if (Board::typeOf(code) < 0 || Board::typeOf(code) >= start.registry->size()) {
+            error = "unknown piece type in material";
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        error = "cannot create " + directory;
+        return false;
+    }
+
+    // Alma ile ulaşılan alt malzemeler önce; son royal taşın alınması oyunu bitirir, tablo gerekmez
+    std::map<std::vector<PieceCode>, std::unique_ptr<Table>> solved;
+    std::vector<std::vector<PieceCode>> order;
+    auto collect = [&](auto &&self, const std::vector<PieceCode> &current) -> void {
+        if (solved.count(current)) return;
+        solved[current] = nullptr;
+        for (std::size_t i = 0; i < current.size(); ++i) {
+            if (i > 0 && current[i] == current[i - 1]) continue;
+            PieceCode victim = current[i];
+            if (start.isRoyal(victim) &&
+                std::count_if(current.begin(), current.end(), [&](PieceCode code) {
+                    return Board::colorOf(code) == Board::colorOf(victim) && start.isRoyal(code);
+                }) == 1) {
+                continue;
+            }
+            std::vector<PieceCode> sub(current);
+            sub.erase(sub.begin() + static_cast<std::ptrdiff_t>(i));
+            self(self, sub);
+        }
+        order.push_back(current);
+    };
+    collect(collect, material);
+
+    for (const auto &current : order) {
+        std::string path = (std::filesystem::path(directory) / fileName(start, current)).string();
+        std::string ignored;
+        auto table = openTable(path, start, variantHash, ignored);
+        if (table && table->layout.material() == current) {
+            ++stats.reused;
+        } else {
+            std::vector<const Table *> subTables;
+            for (const auto &[key, sub] : solved) {
+                if (sub) subTables.push_back(sub.get());
+            }
+
+            Layout layout(start, current);
+            Solver solver(start, layout, subTables, options.jobs);
+            if (!solver.solve(options.memoryMb, error)) {
+                error = fileName(start, current) + ": " + error;
+                return false;
+            }
+            if (!writeTable(path, start, variantHash, layout, solver, options.dtm && solver.distancesKnown())) {
+                error = "failed to write " + path;
+                return false;
+            }
+            table = openTable(path, start, variantHash, error);
+            if (!table) return false;
+            ++stats.tables;
+
+            if (current == material) {
+                stats.symmetries = layout.symmetries();
+                for (std::uint64_t i = 0; i < layout.size(); ++i) {
+                    std::uint8_t code = solver.code(i);
+                    if (code == CODE_INVALID) continue;
+                    ++stats.positions;
+                    if (code == CODE_WIN) ++stats.wins;
+                    else if (code == CODE_LOSS) ++stats.losses;
+                    else ++stats.draws;
+                    if (code != CODE_DRAW) stats.maxDtm = std::max(stats.maxDtm, solver.distance(i));
+                }
+            }
+        }
+        solved[current] = std::move(table);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Sorgu
+
+Tablebase::Tablebase() = default;
+
+Tablebase::~Tablebase() {
+    close();
+}
+
+bool Tablebase::open(const std::string &directory, const Board &start, std::uint64_t variantHash) {
+    close();
+
+    std::error_code ec;
+    std::vector<std::string> paths;
+    for (const auto &file : std::filesystem::directory_iterator(directory, ec)) {
+        if (file.path().extension() == ".ctb") paths.push_back(file.path().string());
+    }
+    if (ec) {
+        lastError = "cannot read " + directory;
+        return false;
+    }
+    std::sort(paths.begin(), paths.end());
+
+    // Başka varyantlar için yazılmış tablolar atlanır
+    for (const auto &path : paths) {
+        std::string ignored;
+        auto table = openTable(path, start, variantHash, ignored);
+        if (!table) continue;
+        largest = std::max(largest, static_cast<int>(table->layout.material().size()));
+        tables.push_back(std::move(table));
+    }
+    if (tables.empty()) {
+        lastError = "no tablebases for this variant in " + directory;
+        return false;
+    }
+    lastError.clear();
+    return true;
+}
+
+void Tablebase::close() {
+    tables.clear();
+    largest = 0;
+}
+
+const Tablebase::Table *Tablebase::findTable(const Board &board) const {
+    PieceCode codes[MAX_PIECES + 1];
+    int count = materialOf(board, codes, largest);
+    if (count > largest) return nullptr;
+    for (const auto &table : tables) {
+        const auto &material = table->layout.material();
+        if (static_cast<int>(material.size()) == count && std::equal(material.begin(), material.end(), codes)) {
+            return table.get();
+        }
+    }
+    return nullptr;
+}
+
+bool Tablebase::probe(const Board &board, Result &result) const {
+    const Table *table = findTable(board);
+    return table && table->probe(board, result);
+}
+
+Move Tablebase::bestMove(Board &board, Result *rootResult) const {
+    Result root;
+    if (!probe(board, root)) return Move();
+    if (rootResult) *rootResult = root;
+
+    bool hadRoyal[2] = {!board.royalsOf(true).empty(), !board.royalsOf(false).empty()};
+    MoveList moves;
+    Rules::generateLegalMoves(board, board.whiteToMove, moves);
+
+    Move best;
+    int bestRank = 0;
+    Board::UndoRecord undo;
+    for (Move move : moves) {
+        board.makeMove(move, undo);
+        Result child;
+        int victim = board.whiteToMove ? Board::WHITE : Board::BLACK;
+        bool known = true;
+        if (hadRoyal[victim] && board.royalsOf(board.whiteToMove).empty()) {
+            child = {Wdl::LOSS, 0};
+        } else {
+            known = probe(board, child);
+        }
+        board.unmakeMove(undo);
+        if (!known) return Move();
+
+        // Sıralama: rakibe kaybettiren hamleler en iyi, mesafe kazançta kısa, kayıpta uzun olmalı
+        int distance = child.dtm < 0 ? DTM_UNKNOWN : child.dtm;
+        int rank = child.wdl == Wdl::LOSS ? 2000 - distance : child.wdl == Wdl::DRAW ? 1000 : distance;
+        if (best.isNone() || rank > bestRank) {
+            best = move;
+            bestRank = rank;
+        }
+    }
+    return best;
+}
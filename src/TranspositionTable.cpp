@@ -0,0 +1,99 @@
+#include "TranspositionTable.hpp"
+
+#include <algorithm>
+
+TranspositionTable::TranspositionTable(std::size_t sizeMb) {
+    resize(sizeMb);
+}
+
+void TranspositionTable::resize(std::size_t sizeMb) {
+    std::size_t bytes = std::max<std::size_t>(sizeMb, 1) * 1024 * 1024;
+    std::size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= bytes) {
+        count *= 2;
+    }
+
+    table = std::make_unique<Bucket[]>(count);
+    buckets = count;
+    generation = 0;
+}
+
+void TranspositionTable::clear() {
+    for (std::size_t i = 0; i < buckets; ++i) {
+        for (auto &slot : table[i].entries) {
+            slot.keyXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation = static_cast<std::uint8_t>((generation + 1) & 63);
+}
+
+bool TranspositionTable::probe(std::uint64_t key, TTEntry &entry) const {
+    const Bucket &bucket = bucketFor(key);
+    for (const auto &slot : bucket.entries) {
+        TTEntry candidate = slot.load();
+        if (candidate.key == key && candidate.bound() != Bound::NONE) {
+            entry = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, Move move, int score, int depth, Bound bound) {
+    Bucket &bucket = bucketFor(key);
+    int currentGeneration = generation.load(std::memory_order_relaxed);
+
+    // Aynı konum varsa onu, yoksa boş girişi, o da yoksa en değersiz girişi değiştir
+    Slot *replace = &bucket.entries[0];
+    TTEntry existing = replace->load();
+    int worstValue = 1 << 30;
+    for (auto &slot : bucket.entries) {
+        TTEntry candidate = slot.load();
+        if (candidate.key == key || candidate.bound() == Bound::NONE) {
+            replace = &slot;
+            existing = candidate;
+            break;
+        }
+        int staleness = (currentGeneration - candidate.age()) & 63;
+        int value = candidate.depth - 4 * staleness;
+        if (value < worstValue) {
+            worstValue = value;
+            replace = &slot;
+            existing = candidate;
+        }
+    }
+
+    // Aynı konumun daha derin kaydını sığ ve kesin olmayan bir sonuçla ezme
+    if (existing.key == key && existing.bound() != Bound::NONE && bound != Bound::EXACT &&
+        depth < existing.depth && existing.age() == currentGeneration) {
+        return;
+    }
+
+    TTEntry entry;
+    entry.key = key;
+    entry.move = move.isNone() && existing.key == key ? existing.move : move.compact();
+    entry.score = static_cast<std::int16_t>(std::clamp(score, -32767, 32767));
+    entry.depth = static_cast<std::int8_t>(std::clamp(depth, -128, 127));
+    entry.boundAndAge = static_cast<std::uint8_t>(static_cast<std::uint8_t>(bound) | (currentGeneration << 2));
+    replace->save(entry);
+}
+
+int TranspositionTable::hashfull() const {
+    std::size_t sample = std::min<std::size_t>(buckets, 1000 / BUCKET_SIZE + 1);
+    int currentGeneration = generation.load(std::memory_order_relaxed);
+    int used = 0;
+    int total = 0;
+    for (std::size_t i = 0; i < sample; ++i) {
+        for (const auto &slot : table[i].entries) {
+            TTEntry entry = slot.load();
+            ++total;
+            if (entry.bound() != Bound::NONE && entry.age() == currentGeneration) ++used;
+        }
+    }
+    return total ? used * 1000 / total : 0;
+}
@@ -0,0 +1,462 @@
+#include "VariantSnapshot.hpp"
+#include "GameRecord.hpp"
+#include "PieceRegistry.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sys/stat.h>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+const char MAGIC[4] = {'C', 'V', 'A', 'R'};
+
+static_assert(sizeof(int) == sizeof(std::int32_t), "tables are stored as 32-bit integers");
+static_assert(std::is_trivial_v<MovementTable::Ray>, "rays are stored as raw bytes");
+
+// FNV-1a, bayt yerine 64 bitlik kelimeler üzerinde (yük 8'in katı değilse kalan baytlar tek tek)
+std::uint64_t checksum(const std::uint8_t *data, std::size_t length) {
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001B3ULL;
+    }
+    for (; i < length; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Kaynak dosyanın boyutu ve değişme zamanı (ns); dosya yoksa false
+bool sourceStamp(const std::string &path, std::uint64_t &size, std::int64_t &mtime) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return false;
+    size = static_cast<std::uint64_t>(info.st_size);
+    mtime = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    return true;
+}
+
+class PayloadWriter {
+public:
+    template <typename T>
+    void put(T value) {
+        std::uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putInt(int value) { put(static_cast<std::int32_t>(value)); }
+    void putBool(bool value) { put(static_cast<std::uint8_t>(value)); }
+    void putSize(std::size_t value) { put(static_cast<std::uint32_t>(value)); }
+
+    void putString(const std::string &text) {
+        putSize(text.size());
+        data.insert(data.end(), text.begin(), text.end());
+    }
+
+    void putPosition(const Position &pos) {
+        putInt(pos.x);
+        putInt(pos.y);
+    }
+
+    // Ham diziler 4 baytlık sınırda başlar; okuyucu onları yerinde görebilir
+    void align() { data.resize((data.size() + 3) & ~std::size_t(3), 0); }
+
+    void putBytes(const void *bytes, std::size_t length) {
+        const auto *begin = static_cast<const std::uint8_t *>(bytes);
+        data.insert(data.end(), begin, begin + length);
+    }
+
+    void putInts(const std::vector<int> &values) {
+        putSize(values.size());
+        align();
+        putBytes(values.data(), values.size() * sizeof(int));
+    }
+
+    std::vector<std::uint8_t> data;
+};
+
+// Sınır denetimli okuyucu; veri biterse sonraki tüm okumalar sıfır döner ve ok() false olur
+class PayloadReader {
+public:
+    PayloadReader(const std::uint8_t *data, std::size_t length) : begin(data), data(data), end(data + length) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (static_cast<std::size_t>(end - data) < sizeof(T)) {
+            failed = true;
+            data = end;
+            return value;
+        }
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return value;
+    }
+
+    int getInt() { return get<std::int32_t>(); }
+    bool getBool() { return get<std::uint8_t>() != 0; }
+
+    // Kalan veriden uzun olamayacak bir eleman sayısı
+    std::size_t getSize(std::size_t elementSize) {
+        std::size_t count = get<std::uint32_t>();
+        if (count > static_cast<std::size_t>(end - data) / elementSize) {
+            failed = true;
+            data = end;
+            return 0;
+        }
+        return count;
+    }
+
+    std::string getString() {
+        std::size_t length = getSize(1);
+        std::string text(reinterpret_cast<const char *>(data), length);
+        data += length;
+        return text;
+    }
+
+    Position getPosition() {
+        Position pos;
+        pos.x = getInt();
+        pos.y = getInt();
+        return pos;
+    }
+
+    // Hizalanmış ham dizi; eşlenmiş bellekten tek kopyayla alınır
+    template <typename T>
+    std::vector<T> getArray() {
+        std::size_t count = get<std::uint32_t>();
+        data = std::min(end, begin + ((data - begin + 3) & ~std::ptrdiff_t(3)));
+        if (count > static_cast<std::size_t>(end - data) / sizeof(T)) {
+            failed = true;
+            data = end;
+            return {};
+        }
+        const T *first = reinterpret_cast<const T *>(data);
+        data += count * sizeof(T);
+        return std::vector<T>(first, first + count);
+    }
+
+    std::vector<int> getInts() { return getArray<int>(); }
+
+    bool ok() const { return !failed; }
+    bool atEnd() const { return data == end; }
+
+private:
+    const std::uint8_t *begin;
+    const std::uint8_t *data;
+    const std::uint8_t *end;
+    bool failed = false;
+};
+
+void writePiece(PayloadWriter &out, const PieceConfig &piece) {
+    out.putString(piece.type);
+    out.putInt(piece.count);
+
+    const Movement &m = piece.movement;
+    for (int value : {m.forward, m.sideways, m.diagonal, static_cast<int>(m.l_shape), m.diagonal_capture,
+                      m.first_move_forward}) {
+        out.putInt(value);
+    }
+
+    const SpecialAbilities &a = piece.special_abilities;
+    for (bool value : {a.castling, a.royal, a.jump_over, a.promotion, a.en_passant}) {
+        out.putBool(value);
+    }
+    out.putSize(a.custom_abilities.size());
+    for (const auto &[name, enabled] : a.custom_abilities) {
+        out.putString(name);
+        out.putBool(enabled);
+    }
+
+    // Renk anahtarının varlığı da korunur (doğrulama boş konum listesini ayırt eder)
+    for (const char *color : {"white", "black"}) {
+        auto it = piece.positions.find(color);
+        out.putBool(it != piece.positions.end());
+        if (it == piece.positions.end()) continue;
+        out.putSize(it->second.size());
+        for (const auto &pos : it->second) out.putPosition(pos);
+    }
+}
+
+PieceConfig readPiece(PayloadReader &in) {
+    PieceConfig piece;
+    piece.type = in.getString();
+    piece.count = in.getInt();
+
+    Movement &m = piece.movement;
+    m.forward = in.getInt();
+    m.sideways = in.getInt();
+    m.diagonal = in.getInt();
+    m.l_shape = in.getInt() != 0;
+    m.diagonal_capture = in.getInt();
+    m.first_move_forward = in.getInt();
+
+    SpecialAbilities &a = piece.special_abilities;
+    a.castling = in.getBool();
+    a.royal = in.getBool();
+    a.jump_over = in.getBool();
+    a.promotion = in.getBool();
+    a.en_passant = in.getBool();
+    for (std::size_t i = 0, count = in.getSize(5); i < count; ++i) {
+        std::string name = in.getString();
+        a.custom_abilities[name] = in.getBool();
+    }
+
+    for (const char *color : {"white", "black"}) {
+        if (!in.getBool()) continue;
+        auto &positions = piece.positions[color];
+        positions.resize(in.getSize(8));
+        for (auto &pos : positions) pos = in.getPosition();
+    }
+    return piece;
+}
+
+// Işınlar yapı düzeniyle ham yazılır; dolgu baytları sıfırlanır ki aynı varyant aynı dosyayı versin
+void writeTable(PayloadWriter &out, const MovementTable &table) {
+    using Ray = MovementTable::Ray;
+    const auto &rays = table.rayData();
+    std::vector<std::uint8_t> raw(rays.size() * sizeof(Ray), 0);
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+        std::uint8_t *slot = raw.data() + i * sizeof(Ray);
+        const Ray &ray = rays[i];
+        std::memcpy(slot + offsetof(Ray, begin), &ray.begin, sizeof(ray.begin));
+        std::memcpy(slot + offsetof(Ray, step), &ray.step, sizeof(ray.step));
+        std::memcpy(slot + offsetof(Ray, moveLength), &ray.moveLength, sizeof(ray.moveLength));
+        std::memcpy(slot + offsetof(Ray, captureLength), &ray.captureLength, sizeof(ray.captureLength));
+        std::memcpy(slot + offsetof(Ray, doubleStepFrom), &ray.doubleStepFrom, sizeof(ray.doubleStepFrom));
+        std::memcpy(slot + offsetof(Ray, moveReach), &ray.moveReach, sizeof(ray.moveReach));
+        std::memcpy(slot + offsetof(Ray, captureReach), &ray.captureReach, sizeof(ray.captureReach));
+    }
+    out.putSize(rays.size());
+    out.align();
+    out.putBytes(raw.data(), raw.size());
+    out.putInts(table.leapData());
+    out.putInts(table.leapStartData());
+}
+
+bool sameTable(const MovementTable &a, const MovementTable &b) {
+    return a.leapData() == b.leapData() && a.leapStartData() == b.leapStartData() &&
+           std::equal(a.rayData().begin(), a.rayData().end(), b.rayData().begin(), b.rayData().end(),
+                      [](const MovementTable::Ray &x, const MovementTable::Ray &y) {
+                          return x.begin == y.begin && x.step == y.step && x.moveLength == y.moveLength &&
+                                 x.captureLength == y.captureLength && x.doubleStepFrom == y.doubleStepFrom &&
+                                 x.moveReach == y.moveReach && x.captureReach == y.captureReach;
+                      });
+}
+
+// Tabloyu oku; içerik özetle korunur, burada yalnızca dizi boyları tahtayla denetlenir
+bool readTable(PayloadReader &in, int color, int boardSize, std::vector<MovementTable> &tables) {
+    std::vector<MovementTable::Ray> rays = in.getArray<MovementTable::Ray>();
+    std::vector<int> leaps = in.getInts();
+    std::vector<int> leapStart = in.getInts();
+    if (!in.ok()) return false;
+
+    // L hamlesi olmayan taşların sıçrama tablosu boştur
+    std::size_t squareCount = static_cast<std::size_t>(boardSize) * boardSize;
+    if (rays.size() != MovementTable::rayCount(boardSize) ||
+        (leapStart.size() != squareCount + 1 && !(leapStart.empty() && leaps.empty()))) {
+        return false;
+    }
+    tables.emplace_back(color, boardSize, std::move(rays), std::move(leaps), std::move(leapStart));
+    return true;
+}
+
+bool decode(PayloadReader &in, GameConfig &config, std::string &error) {
+    config = GameConfig();
+    config.game_settings.name = in.getString();
+    config.game_settings.board_size = in.getInt();
+    config.game_settings.turn_limit = in.getInt();
+
+    for (auto *pieces : {&config.pieces, &config.custom_pieces}) {
+        pieces->resize(in.getSize(1));
+        for (auto &piece : *pieces) piece = readPiece(in);
+    }
+
+    config.portals.resize(in.getSize(1));
+    for (auto &portal : config.portals) {
+        portal.type = in.getString();
+        portal.id = in.getString();
+        portal.positions.entry = in.getPosition();
+        portal.positions.exit = in.getPosition();
+        portal.properties.preserve_direction = in.getBool();
+        portal.properties.cooldown = in.getInt();
+        portal.properties.allowed_colors.resize(in.getSize(4));
+        for (auto &color : portal.properties.allowed_colors) color = in.getString();
+    }
+
+    int boardSize = config.game_settings.board_size;
+    if (!in.ok() || boardSize <= 0 || boardSize > ConfigReader::MAX_BOARD_SIZE) {
+        error = "corrupt configuration section";
+        return false;
+    }
+
+    std::size_t typeCount = in.getSize(1);
+    if (in.get<std::uint32_t>() != sizeof(MovementTable::Ray)) {
+        error = "movement tables were compiled with a different layout";
+        return false;
+    }
+    std::vector<MovementTable> tables;
+    tables.reserve(typeCount * 2);
+    for (std::size_t i = 0; i < typeCount; ++i) {
+        if (!readTable(in, 0, boardSize, tables)) {
+            error = "corrupt movement table";
+            return false;
+        }
+        // Yöne bağlı olmayan taşlarda siyahın tablosu beyazınkiyle aynıdır ve yazılmaz
+        if (in.getBool()) {
+            tables.push_back(tables.back());
+        } else if (!readTable(in, 1, boardSize, tables)) {
+            error = "corrupt movement table";
+            return false;
+        }
+    }
+    if (!in.atEnd()) {
+        error = "unexpected data after movement tables";
+        return false;
+    }
+
+    std::vector<PieceConfig> allPieces = config.pieces;
+    allPieces.insert(allPieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+    auto registry = std::make_shared<const PieceRegistry>(allPieces, boardSize, std::move(tables));
+    if (static_cast<std::size_t>(registry->size()) != typeCount) {
+        error = "movement tables do not match the piece types";
+        return false;
+    }
+    config.compiled_registry = std::move(registry);
+    return true;
+}
+
+bool decodeMapped(const std::uint8_t *data, std::size_t length, const std::string &path,
+                  const std::string &sourcePath, GameConfig &config, std::string &error) {
+    std::uint16_t version;
+    std::uint64_t payloadSize, payloadSum, sourceSize;
+    std::int64_t sourceTime;
+    std::memcpy(&version, data + 4, sizeof(version));
+    std::memcpy(&payloadSize, data + 8, sizeof(payloadSize));
+    std::memcpy(&payloadSum, data + 16, sizeof(payloadSum));
+    std::memcpy(&sourceSize, data + 24, sizeof(sourceSize));
+    std::memcpy(&sourceTime, data + 32, sizeof(sourceTime));
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || version != VariantSnapshot::VERSION) {
+        error = path + " is not a version " + std::to_string(VariantSnapshot::VERSION) + " variant snapshot";
+        return false;
+    }
+    const std::uint8_t *payload = data + VariantSnapshot::HEADER_SIZE;
+    if (payloadSize != length - VariantSnapshot::HEADER_SIZE || checksum(payload, payloadSize) != payloadSum) {
+        error = path + " is damaged (checksum mismatch)";
+        return false;
+    }
+
+    // Kaynak JSON değiştiyse görüntü eskidir; kaynak yoksa görüntü tek başına geçerlidir
+    std::uint64_t currentSize;
+    std::int64_t currentTime;
+    if (!sourcePath.empty() && sourceStamp(sourcePath, currentSize, currentTime) &&
+        (currentSize != sourceSize || currentTime != sourceTime)) {
+        error = path + " is older than " + sourcePath;
+        return false;
+    }
+
+    PayloadReader in(payload, payloadSize);
+    if (!decode(in, config, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+std::string VariantSnapshot::pathFor(const std::string &configPath) {
+    std::size_t slash = configPath.find_last_of('/');
+    std::size_t dot = configPath.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return configPath + ".cvar";
+    return configPath.substr(0, dot) + ".cvar";
+}
+
+bool VariantSnapshot::isSnapshot(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool VariantSnapshot::write(const GameConfig &config, const std::string &path, const std::string &sourcePath,
+                            std::string &error) {
+    std::uint64_t sourceSize = 0;
+    std::int64_t sourceTime = 0;
+    if (!sourcePath.empty() && !sourceStamp(sourcePath, sourceSize, sourceTime)) {
+        error = "cannot stat " + sourcePath;
+        return false;
+    }
+
+    PayloadWriter out;
+    out.putString(config.game_settings.name);
+    out.putInt(config.game_settings.board_size);
+    out.putInt(config.game_settings.turn_limit);
+
+    for (const auto *pieces : {&config.pieces, &config.custom_pieces}) {
+        out.putSize(pieces->size());
+        for (const auto &piece : *pieces) writePiece(out, piece);
+    }
+
+    out.putSize(config.portals.size());
+    for (const auto &portal : config.portals) {
+        out.putString(portal.type);
+        out.putString(portal.id);
+        out.putPosition(portal.positions.entry);
+        out.putPosition(portal.positions.exit);
+        out.putBool(portal.properties.preserve_direction);
+        out.putInt(portal.properties.cooldown);
+        out.putSize(portal.properties.allowed_colors.size());
+        for (const auto &color : portal.properties.allowed_colors) out.putString(color);
+    }
+
+    PieceRegistry registry(config);
+    out.putSize(static_cast<std::size_t>(registry.size()));
+    out.put(static_cast<std::uint32_t>(sizeof(MovementTable::Ray)));
+    for (int type = 0; type < registry.size(); ++type) {
+        const auto &moves = registry.type(type).moves;
+        writeTable(out, *moves[0]);
+        bool shared = sameTable(*moves[0], *moves[1]);
+        out.putBool(shared);
+        if (!shared) writeTable(out, *moves[1]);
+    }
+
+    std::uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    std::uint16_t version = VERSION;
+    std::uint64_t payloadSize = out.data.size();
+    std::uint64_t payloadSum = checksum(out.data.data(), out.data.size());
+    std::uint64_t variantHash = ConfigReader::hashConfig(config);
+    std::memcpy(header + 4, &version, sizeof(version));
+    std::memcpy(header + 8, &payloadSize, sizeof(payloadSize));
+    std::memcpy(header + 16, &payloadSum, sizeof(payloadSum));
+    std::memcpy(header + 24, &sourceSize, sizeof(sourceSize));
+    std::memcpy(header + 32, &sourceTime, sizeof(sourceTime));
+    std::memcpy(header + 40, &variantHash, sizeof(variantHash));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(out.data.data()), static_cast<std::streamsize>(out.data.size()));
+    if (!file.good()) {
+        error = "failed to write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool VariantSnapshot::load(const std::string &path, const std::string &sourcePath, GameConfig &config,
+                           std::string &error) {
+    MappedFile file;
+    if (!file.map(path, HEADER_SIZE, "a variant snapshot", error)) return false;
+
+    bool ok = decodeMapped(file.data(), file.size(), path, sourcePath, config, error);
+    if (!ok) config = GameConfig();
+    return ok;
+}
+
@@ -1,9 +1,16 @@
+#include "BoardRenderer.hpp"
+#include "ComputerPlayer.hpp"
 #include "ConfigReader.hpp"
 #include "Game.hpp"
+#include "GameRecord.hpp"
 #include "MoveValidator.hpp"
+#include "Notation.hpp"
 #include "Rules.hpp"
+#include "Tablebase.hpp"
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 void displaySpecialAbilities(const SpecialAbilities &abilities) {
     if (abilities.castling) std::cout << "Castling ";
@@ -45,35 +52,7 @@ void displayPieceInfo(const PieceConfig &piece) {
     }
 }
 
-int fileToX(char file) { return file - 'a'; }
-int rankToY(char rank, int boardSize) { return boardSize - (rank - '0'); }
-
-bool isKingAlive(const Board &board, bool isWhite) {
-    for (int y = 0; y < board.board_size; ++y) {
-        for (int x = 0; x < board.board_size; ++x) {
-            auto piece = board.getPiece(x, y);
-            if (piece && piece->type == "King" && piece->getIsWhite() == isWhite) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-int main(int argc, char *argv[]) {
-    std::string configPath = "data/chess_pieces.json";
-    if (argc > 1) {
-        configPath = argv[1];
-    }
-
-    ConfigReader configReader;
-    if (!configReader.loadFromFile(configPath)) {
-        std::cerr << "Failed to load configuration. Exiting.\n";
-        return 1;
-    }
-
-    const GameConfig &config = configReader.getConfig();
-
+void displayConfig(const GameConfig &config) {
     std::cout << "==== Game Configuration ====\n";
     std::cout << "Game: " << config.game_settings.name << "\n";
     std::cout << "Board size: " << config.game_settings.board_size << "x" << config.game_settings.board_size << "\n";
@@ -104,75 +83,224 @@ int main(int argc, char *argv[]) {
         }
         std::cout << "\n";
     }
+}
+
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " [config.json|config.cvar|" << ConfigReader::STANDARD_VARIANT
+              << "] [--white human|computer] [--black human|computer]\n"
+              << "       [--depth N] [--nodes N] [--movetime MS] [--threads N] [--hash MB] [--record FILE]\n"
+              << "       [--book FILE] [--tablebase DIR] [--show-config]\n";
+}
+
+int main(int argc, char *argv[]) {
+    std::string configPath = "data/chess_pieces.json";
+    bool computerSide[2] = {false, false};
+    SearchLimits limits;
+    std::size_t hashMb = 16;
+    std::string recordPath;
+    std::string bookPath;
+    std::string tablebasePath;
+    bool showConfig = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--white" || arg == "--black") && i + 1 < argc) {
+            std::string player = argv[++i];
+            if (player != "human" && player != "computer") {
+                printUsage(argv[0]);
+                return 1;
+            }
+            computerSide[arg == "--white" ? Board::WHITE : Board::BLACK] = player == "computer";
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--book" && i + 1 < argc) {
+            bookPath = argv[++i];
+        } else if (arg == "--tablebase" && i + 1 < argc) {
+            tablebasePath = argv[++i];
+        } else if (arg == "--show-config") {
+            showConfig = true;
+        } else if (ComputerPlayer::parseOption(argc, argv, i, limits, hashMb)) {
+            continue;
+        } else if (arg.rfind("--", 0) == 0) {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            configPath = arg;
+        }
+    }
+
+    // Sınır verilmezse bilgisayar hamle başına bir saniye düşünür
+    if (limits.maxNodes == 0 && limits.moveTimeMs == 0 && limits.maxDepth == SearchLimits().maxDepth) {
+        limits.moveTimeMs = 1000;
+    }
+
+    ConfigReader configReader;
+    if (!configReader.loadFromFile(configPath)) {
+        std::cerr << "Failed to load configuration. Exiting.\n";
+        return 1;
+    }
+
+    const GameConfig &config = configReader.getConfig();
+
+    if (showConfig) {
+        displayConfig(config);
+    } else {
+        std::cout << "Game: " << config.game_settings.name << " (" << config.game_settings.board_size << "x"
+                  << config.game_settings.board_size << ", " << config.portals.size() << " portals)\n";
+    }
 
     std::cout << "\n==== Starting Game ====\n";
     Board board(config.game_settings.board_size);
-    board.initialize(config.pieces, config.portals);
-    board.print();
+    board.initialize(config);
+
+    // Terminalde tahta ekranın üstünde kalır ve her hamlede yalnızca değişen kareler çizilir
+    BoardRenderer renderer(std::cout, BoardRenderer::isTerminal());
+    renderer.render(board);
+
+    std::shared_ptr<OpeningBook> book;
+    if (!bookPath.empty()) {
+        book = std::make_shared<OpeningBook>();
+        if (!book->open(bookPath)) {
+            std::cerr << book->error() << "\n";
+            return 1;
+        }
+        if (book->variantHash() != ConfigReader::hashConfig(config)) {
+            std::cerr << bookPath << " was built for a different variant\n";
+            return 1;
+        }
+    }
+
+    std::shared_ptr<Tablebase> tablebase;
+    if (!tablebasePath.empty()) {
+        tablebase = std::make_shared<Tablebase>();
+        if (!tablebase->open(tablebasePath, board, ConfigReader::hashConfig(config))) {
+            std::cerr << tablebase->error() << "\n";
+            return 1;
+        }
+    }
+
+    std::unique_ptr<ComputerPlayer> computers[2];
+    for (int color = 0; color < 2; ++color) {
+        if (computerSide[color]) {
+            computers[color] = std::make_unique<ComputerPlayer>(limits, hashMb);
+            computers[color]->setBook(book);
+            computers[color]->setTablebase(tablebase);
+        }
+    }
+
+    // Tekrar tespiti için oynanmış konumların anahtarları
+    std::vector<std::uint64_t> positionKeys;
+
+    // --record için oynanan hamleler ve sonuç
+    std::vector<Move> played;
+    GameResult result = GameResult::DRAW;
 
     bool isWhiteTurn = true;
     int turn = 1;
 
+    // Sırası gelen tarafın yasal hamlesi yok: şahtaysa mat, değilse pat
+    auto endWithoutMoves = [&]() {
+        if (Rules::isCheck(board, isWhiteTurn)) {
+            result = isWhiteTurn ? GameResult::BLACK_WINS : GameResult::WHITE_WINS;
+            std::cout << (isWhiteTurn ? "Black" : "White") << " wins! No legal moves left.\n";
+        } else {
+            result = GameResult::DRAW;
+            std::cout << "Stalemate! Game is a draw.\n";
+        }
+    };
+
     while (turn <= config.game_settings.turn_limit) {
-        std::string input;
-        std::cout << (isWhiteTurn ? "White" : "Black") << "'s move (or type 'exit' to quit): ";
-        std::getline(std::cin, input);
+        // Tablodaki konumlarda mat hamle üretmeden bilinir; zorunlu mat duyurulur
+        Tablebase::Result known;
+        if (tablebase && tablebase->probe(board, known) && known.wdl != Tablebase::Wdl::DRAW) {
+            bool whiteWins = (known.wdl == Tablebase::Wdl::WIN) == isWhiteTurn;
+            if (known.dtm == 0) {
+                result = whiteWins ? GameResult::WHITE_WINS : GameResult::BLACK_WINS;
+                std::cout << (whiteWins ? "White" : "Black") << " wins! Checkmate.\n";
+                break;
+            }
+            if (known.dtm > 0) {
+                std::cout << "Tablebase: " << (whiteWins ? "White" : "Black") << " mates in " << (known.dtm + 1) / 2
+                          << "\n";
+            }
+        }
 
-        if (input == "exit") {
-            std::cout << "Game exited by user.\n";
+        if (!Rules::hasAnyLegalMove(board, isWhiteTurn)) {
+            endWithoutMoves();
             break;
         }
 
-        if (input.length() == 4 &&
-            input[0] >= 'a' && input[0] <= 'h' &&
-            input[2] >= 'a' && input[2] <= 'h' &&
-            input[1] >= '1' && input[1] <= '8' &&
-            input[3] >= '1' && input[3] <= '8') {
+        Move move;
+        auto &computer = computers[isWhiteTurn ? Board::WHITE : Board::BLACK];
+
+        if (computer) {
+            move = computer->chooseMove(board, positionKeys, &std::cout);
+            if (move.isNone()) {
+                endWithoutMoves();
+                break;
+            }
+            std::cout << (isWhiteTurn ? "White" : "Black") << " (computer) plays "
+                      << Notation::moveToString(board, move) << "\n";
+        } else {
+            std::string input;
+            std::cout << (isWhiteTurn ? "White" : "Black") << "'s move (or type 'exit' to quit): ";
+            std::getline(std::cin, input);
 
-            int x1 = fileToX(input[0]);
-            int y1 = rankToY(input[1], board.board_size);
-            int x2 = fileToX(input[2]);
-            int y2 = rankToY(input[3], board.board_size);
+            if (input == "exit" || !std::cin) {
+                result = GameResult::UNKNOWN;
+                std::cout << "Game exited by user.\n";
+                break;
+            }
 
-            if (!board.isPositionValid({x1, y1}) || !board.isPositionValid({x2, y2})) {
-                std::cout << "Invalid coordinates.\n";
+            int x1, y1, x2, y2;
+            bool viaPortal;
+            if (!Notation::parseMove(input, board.board_size, x1, y1, x2, y2, &viaPortal)) {
+                std::cout << "Invalid input format! Use format like a2a4 (a2a4* to continue through a portal).\n";
                 continue;
             }
 
-            auto piece = board.getPiece(x1, y1);
-            if (!piece || piece->getIsWhite() != isWhiteTurn) {
+            Rules::MoveError reason;
+            move = Rules::findLegalMove(board, board.squareIndex(x1, y1), board.squareIndex(x2, y2), viaPortal, &reason);
+            if (reason == Rules::MoveError::NO_PIECE || reason == Rules::MoveError::WRONG_SIDE) {
                 std::cout << "No valid piece at source, or not your turn.\n";
                 continue;
             }
-
-            if (!Rules::isValidMove(board, x1, y1, x2, y2)) {
+            if (reason == Rules::MoveError::NOT_A_MOVE) {
                 std::cout << "Invalid move!\n";
                 continue;
             }
-
-            // İlk hareket
-            board.movePiece(x1, y1, x2, y2);
-            int fromPortalX = x2;
-            int fromPortalY = y2;
-            board.handlePortal(x2, y2, x2, y2);
-            if (x2 != fromPortalX || y2 != fromPortalY) {
-                board.movePiece(fromPortalX, fromPortalY, x2, y2);
+            if (reason == Rules::MoveError::LEAVES_ROYAL_IN_CHECK) {
+                std::cout << "Illegal move! Your king would be left in check.\n";
+                continue;
             }
+        }
 
-            isWhiteTurn = !isWhiteTurn;
-            ++turn;
-            board.print();
+        // Hamle ve varsa portal geçişi
+        positionKeys.push_back(board.key());
+        played.push_back(move);
+        Board::UndoRecord undo;
+        board.makeMove(move, undo);
+        if (undo.portal >= 0) {
+            int entry = board.portals.entrySquare(undo.portal);
+            int exit = board.portals.exitSquare(undo.portal);
+            std::cout << "Moved through portal: " << Notation::squareToString(board.squareX(entry), board.squareY(entry), board.board_size)
+                      << " -> " << Notation::squareToString(board.squareX(exit), board.squareY(exit), board.board_size) << "\n";
+        }
 
-            //Kral hayatta mı
-            bool whiteAlive = isKingAlive(board, true);
-            bool blackAlive = isKingAlive(board, false);
-            if (!whiteAlive || !blackAlive) {
-                std::cout << (whiteAlive ? "White" : "Black") << " wins! Opponent's king is gone.\n";
-                break;
-            }
+        isWhiteTurn = !isWhiteTurn;
+        ++turn;
+        renderer.render(board);
+    }
 
-        } else {
-            std::cout << "Invalid input format! Use format like a2a4.\n";
+    if (!recordPath.empty()) {
+        GameRecordWriter record(recordPath, ConfigReader::hashConfig(config), board.board_size);
+        for (Move move : played) {
+            record.addMove(move);
+        }
+        record.endGame(result);
+        if (!record.close()) {
+            std::cerr << "Failed to write game record to " << recordPath << "\n";
+            return 1;
         }
     }
 
@@ -0,0 +1,127 @@
+#include "Board.hpp"
+#include "CommandLine.hpp"
+#include "ConfigReader.hpp"
+#include "Move.hpp"
+#include "Notation.hpp"
+#include "OpeningBook.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " build <config.json> <book.cbk> <games.cgr>... [--plies N] [--min-games N]\n"
+              << "       [--jobs N]\n"
+              << "       " << program << " probe <config.json> <book.cbk> [moves...]\n";
+}
+
+int build(const GameConfig &config, const Board &board, int argc, char *argv[]) {
+    if (argc < 5) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::string bookPath = argv[3];
+    std::vector<std::string> archives;
+    OpeningBook::BuildOptions options;
+
+    for (int i = 4; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--plies" && i + 1 < argc && parseNumber(argv[i + 1], options.maxPly)) {
+            options.maxPly = std::max(0, options.maxPly);
+            ++i;
+        } else if (arg == "--min-games" && i + 1 < argc && parseNumber(argv[i + 1], options.minGames)) {
+            options.minGames = std::max(1, options.minGames);
+            ++i;
+        } else if (arg == "--jobs" && i + 1 < argc && parseNumber(argv[i + 1], options.jobs)) {
+            options.jobs = std::max(1, options.jobs);
+            ++i;
+        } else if (arg.rfind("--", 0) == 0) {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            archives.push_back(arg);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    OpeningBook::BuildStats stats;
+    std::string error;
+    if (!OpeningBook::build(board, ConfigReader::hashConfig(config), archives, bookPath, options, stats, error)) {
+        std::cerr << "Book build failed: " << error << "\n";
+        return 1;
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Games: " << stats.games << " (skipped " << stats.skippedGames << ")\n";
+    std::cout << "Book moves: " << stats.moves << ", entries: " << stats.entries << "\n";
+    std::cout << "Time: " << elapsed << " s\n";
+    return 0;
+}
+
+int probe(const GameConfig &config, Board &board, int argc, char *argv[]) {
+    if (argc < 4) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    OpeningBook book;
+    if (!book.open(argv[3])) {
+        std::cerr << book.error() << "\n";
+        return 1;
+    }
+    if (book.variantHash() != ConfigReader::hashConfig(config)) {
+        std::cerr << argv[3] << " was built for a different variant\n";
+        return 1;
+    }
+    std::string error;
+    if (!Notation::playMoves(board, std::vector<std::string>(argv + 4, argv + argc), error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    // Anahtar çakışmasında girişin hamlesi bu konumda yasal olmayabilir
+    MoveList legal;
+    Rules::generateLegalMoves(board, board.whiteToMove, legal);
+
+    auto [first, last] = book.find(board.key());
+    std::cout << "Book entries: " << (last - first) << "\n";
+    for (auto entry = first; entry != last; ++entry) {
+        Move move = entry->toMove();
+        std::cout << "  " << (!legal.contains(move) ? "(illegal)" : Notation::moveToString(board, move)) << " games " << entry->games
+                  << " +" << entry->wins << " =" << entry->draws << " -" << entry->losses << " score "
+                  << entry->score() / 10.0 << "%\n";
+    }
+
+    Move bookMove = book.probe(board);
+    std::cout << "Book move: " << (bookMove.isNone() ? "none" : Notation::moveToString(board, bookMove)) << "\n";
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string mode = argv[1];
+    if (mode != "build" && mode != "probe") {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    ConfigReader configReader;
+    if (!configReader.loadFromFile(argv[2])) {
+        std::cerr << "Failed to load configuration. Exiting.\n";
+        return 1;
+    }
+
+    const GameConfig &config = configReader.getConfig();
+    Board board(config.game_settings.board_size);
+    board.initialize(config);
+
+    return mode == "build" ? build(config, board, argc, argv) : probe(config, board, argc, argv);
+}
@@ -0,0 +1,99 @@
+#include "ConfigReader.hpp"
+#include "Notation.hpp"
+#include "PieceRegistry.hpp"
+#include "VariantSnapshot.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " <config.json|" << ConfigReader::STANDARD_VARIANT << "> [output.cvar]\n"
+              << "The snapshot defaults to the config path with a .cvar extension; programs given the\n"
+              << "JSON path load it instead of parsing while the JSON file is unchanged.\n";
+}
+
+// ConfigReader'ın kabul ettiği ama tahtanın kuramayacağı yerleşimler: tahta dışı ve çakışan kareler
+bool checkPlacement(const GameConfig &config) {
+    int size = config.game_settings.board_size;
+    std::vector<std::string> owner(static_cast<std::size_t>(size) * size);
+    bool ok = true;
+
+    for (const auto *pieces : {&config.pieces, &config.custom_pieces}) {
+        for (const auto &piece : *pieces) {
+            for (const auto &[color, positions] : piece.positions) {
+                for (const auto &pos : positions) {
+                    std::string name = color + " " + piece.type;
+                    if (pos.x < 0 || pos.x >= size || pos.y < 0 || pos.y >= size) {
+                        std::cerr << name << " at (" << pos.x << "," << pos.y << ") is outside the board\n";
+                        ok = false;
+                        continue;
+                    }
+                    std::string &current = owner[static_cast<std::size_t>(pos.y) * size + pos.x];
+                    if (!current.empty()) {
+                        std::cerr << name << " and " << current << " share "
+                                  << Notation::squareToString(pos.x, pos.y, size) << "\n";
+                        ok = false;
+                    }
+                    current = name;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || argc > 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string configPath = argv[1];
+    std::string outputPath = argc > 2 ? argv[2] : VariantSnapshot::pathFor(configPath);
+
+    // Yerleşik standart varyantın kaynak dosyası yoktur
+    bool standard = configPath == ConfigReader::STANDARD_VARIANT;
+    std::string sourcePath = standard ? "" : configPath;
+
+    ConfigReader configReader;
+    if (!(standard ? configReader.loadStandard() : configReader.loadFromJsonFile(configPath))) {
+        std::cerr << "Failed to load configuration. Exiting.\n";
+        return 1;
+    }
+    const GameConfig &config = configReader.getConfig();
+    if (!checkPlacement(config)) {
+        std::cerr << "Invalid piece placement. Exiting.\n";
+        return 1;
+    }
+
+    std::string error;
+    if (!VariantSnapshot::write(config, outputPath, sourcePath, error)) {
+        std::cerr << "Snapshot failed: " << error << "\n";
+        return 1;
+    }
+
+    // Yazılanı geri oku: aynı varyantı vermeli
+    auto start = std::chrono::steady_clock::now();
+    GameConfig loaded;
+    if (!VariantSnapshot::load(outputPath, sourcePath, loaded, error)) {
+        std::cerr << "Snapshot verification failed: " << error << "\n";
+        return 1;
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (ConfigReader::hashConfig(loaded) != ConfigReader::hashConfig(config)) {
+        std::cerr << "Snapshot verification failed: variant differs after reload\n";
+        return 1;
+    }
+
+    std::cout << "Variant: " << config.game_settings.name << " (" << config.game_settings.board_size << "x"
+              << config.game_settings.board_size << ")\n";
+    std::cout << "Piece types: " << loaded.compiled_registry->size() << ", portals: " << config.portals.size()
+              << "\n";
+    std::cout << "Wrote " << outputPath << " (" << std::filesystem::file_size(outputPath) << " bytes, hash "
+              << std::hex << ConfigReader::hashConfig(config) << std::dec << ")\n";
+    std::cout << "Load time: " << elapsed << " us\n";
+    return 0;
+}
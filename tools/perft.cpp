@@ -0,0 +1,126 @@
+#include "Board.hpp"
+#include "CommandLine.hpp"
+#include "ConfigReader.hpp"
+#include "Move.hpp"
+#include "Notation.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Verilen derinlikteki yaprak sayısı; son katmanda hamleler oynanmadan sayılır
+std::uint64_t perft(Board &board, int depth) {
+    MoveList moves;
+    Rules::generateLegalMoves(board, board.whiteToMove, moves);
+    if (depth <= 1) {
+        return depth == 1 ? moves.size() : 1;
+    }
+
+    std::uint64_t nodes = 0;
+    Board::UndoRecord undo;
+    for (Move move : moves) {
+        board.makeMove(move, undo);
+        nodes += perft(board, depth - 1);
+        board.unmakeMove(undo);
+    }
+    return nodes;
+}
+
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " <config.json> <depth> [--threads N] [--no-divide]\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string configPath = argv[1];
+    int depth = 0;
+    if (!parseNumber(argv[2], depth)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    int threadCount = 1;
+    bool divide = true;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc && parseNumber(argv[i + 1], threadCount)) {
+            threadCount = std::max(1, threadCount);
+            ++i;
+        } else if (arg == "--no-divide") {
+            divide = false;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    ConfigReader configReader;
+    if (!configReader.loadFromFile(configPath)) {
+        std::cerr << "Failed to load configuration. Exiting.\n";
+        return 1;
+    }
+
+    const GameConfig &config = configReader.getConfig();
+    Board board(config.game_settings.board_size);
+    board.initialize(config);
+
+    std::cout << "Variant: " << config.game_settings.name << " (" << config.game_settings.board_size << "x"
+              << config.game_settings.board_size << ")\n";
+    std::cout << "Depth: " << depth << ", threads: " << threadCount << "\n\n";
+
+    MoveList rootMoves;
+    Rules::generateLegalMoves(board, board.whiteToMove, rootMoves);
+    std::vector<std::uint64_t> counts(rootMoves.size(), 0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Kök hamleler iş parçacıkları arasında paylaştırılır; her iş parçacığının kendi tahtası var
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        Board local = board;
+        Board::UndoRecord undo;
+        for (std::size_t i = next++; i < rootMoves.size(); i = next++) {
+            local.makeMove(rootMoves[i], undo);
+            counts[i] = depth > 1 ? perft(local, depth - 1) : 1;
+            local.unmakeMove(undo);
+        }
+    };
+
+    if (depth > 0) {
+        std::vector<std::thread> threads;
+        for (int t = 1; t < threadCount; ++t) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < rootMoves.size(); ++i) {
+        total += counts[i];
+        if (divide) {
+            std::cout << Notation::moveToString(board, rootMoves[i]) << ": " << counts[i] << "\n";
+        }
+    }
+    if (depth == 0) total = 1;
+
+    std::cout << "\nMoves: " << rootMoves.size() << "\n";
+    std::cout << "Nodes: " << total << "\n";
+    std::cout << "Time: " << elapsed << " s\n";
+    std::cout << "NPS: " << static_cast<std::uint64_t>(elapsed > 0 ? total / elapsed : 0) << "\n";
+    return 0;
+}
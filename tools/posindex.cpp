@@ -0,0 +1,138 @@
+#include "Board.hpp"
+#include "CommandLine.hpp"
+#include "ConfigReader.hpp"
+#include "Move.hpp"
+#include "Notation.hpp"
+#include "PositionIndex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " build <config.json> <games.cgr> <index.cpi> [--jobs N] [--memory MB]\n"
+              << "       " << program << " query <config.json> <index.cpi> [moves...] [--limit N]\n";
+}
+
+int build(const GameConfig &config, const Board &board, int argc, char *argv[]) {
+    if (argc < 5) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::string archivePath = argv[3];
+    std::string indexPath = argv[4];
+    int jobs = 1;
+    std::size_t memoryMb = 256;
+
+    for (int i = 5; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc && parseNumber(argv[i + 1], jobs)) {
+            jobs = std::max(1, jobs);
+            ++i;
+        } else if (arg == "--memory" && i + 1 < argc && parseNumber(argv[i + 1], memoryMb)) {
+            memoryMb = std::max<std::size_t>(1, memoryMb);
+            ++i;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    PositionIndex::BuildStats stats;
+    std::string error;
+    if (!PositionIndex::build(board, ConfigReader::hashConfig(config), archivePath, indexPath, jobs, memoryMb, stats,
+                              error)) {
+        std::cerr << "Index build failed: " << error << "\n";
+        return 1;
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Games: " << stats.games << " (skipped " << stats.skippedGames << ")\n";
+    std::cout << "Positions: " << stats.positions << "\n";
+    std::cout << "Sorted runs: " << stats.runs << "\n";
+    std::cout << "Time: " << elapsed << " s\n";
+    std::cout << "Positions/s: " << static_cast<std::uint64_t>(elapsed > 0 ? stats.positions / elapsed : 0) << "\n";
+    return 0;
+}
+
+int query(const GameConfig &config, Board &board, int argc, char *argv[]) {
+    if (argc < 4) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::string indexPath = argv[3];
+    std::vector<std::string> moves;
+    std::size_t limit = 20;
+
+    for (int i = 4; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--limit" && i + 1 < argc && parseNumber(argv[i + 1], limit)) {
+            ++i;
+        } else if (arg.rfind("--", 0) == 0) {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            moves.push_back(arg);
+        }
+    }
+
+    PositionIndex index;
+    if (!index.open(indexPath)) {
+        std::cerr << index.error() << "\n";
+        return 1;
+    }
+    if (index.variantHash() != ConfigReader::hashConfig(config)) {
+        std::cerr << indexPath << " was built for a different variant\n";
+        return 1;
+    }
+    std::string error;
+    if (!Notation::playMoves(board, moves, error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto [first, last] = index.find(board.key());
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t count = static_cast<std::size_t>(last - first);
+    std::cout << "Occurrences: " << count << " (index: " << index.size() << " positions, " << index.gameCount()
+              << " games)\n";
+    for (auto entry = first; entry != last && static_cast<std::size_t>(entry - first) < limit; ++entry) {
+        std::cout << "  game " << entry->game << " ply " << entry->ply << "\n";
+    }
+    if (count > limit) {
+        std::cout << "  ... " << count - limit << " more\n";
+    }
+    std::cout << "Lookup: " << elapsed << " us\n";
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string mode = argv[1];
+    if (mode != "build" && mode != "query") {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    ConfigReader configReader;
+    if (!configReader.loadFromFile(argv[2])) {
+        std::cerr << "Failed to load configuration. Exiting.\n";
+        return 1;
+    }
+
+    const GameConfig &config = configReader.getConfig();
+    Board board(config.game_settings.board_size);
+    board.initialize(config);
+
+    return mode == "build" ? build(config, board, argc, argv) : query(config, board, argc, argv);
+}
@@ -0,0 +1,295 @@
+#include "Board.hpp"
+#include "CommandLine.hpp"
+#include "ConfigReader.hpp"
+#include "GameRecord.hpp"
+#include "Move.hpp"
+#include "Notation.hpp"
+#include "Rules.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Bir hamleyi neden reddettiğimiz
+enum class Verdict { OK, BAD_NOTATION, GAME_OVER, NO_PIECE, WRONG_SIDE, NOT_A_MOVE, LEAVES_ROYAL_IN_CHECK };
+
+const char *verdictName(Verdict verdict) {
+    switch (verdict) {
+    case Verdict::OK: return "ok";
+    case Verdict::BAD_NOTATION: return "bad notation";
+    case Verdict::GAME_OVER: return "game already over";
+    case Verdict::NO_PIECE: return "no piece on source square";
+    case Verdict::WRONG_SIDE: return "not the side to move";
+    case Verdict::NOT_A_MOVE: return "piece cannot move there";
+    case Verdict::LEAVES_ROYAL_IN_CHECK: return "leaves royal piece in check";
+    }
+    return "";
+}
+
+struct FileStats {
+    std::uint64_t games = 0;
+    std::uint64_t moves = 0;
+    std::uint64_t illegalGames = 0;
+    std::vector<std::string> reports;   // yalnızca hatalı oyunlar için
+    bool opened = true;
+};
+
+// Tek bir oyunun tahtası; her satırda başlangıç konumuna geri kopyalanır
+class Replayer {
+public:
+    Replayer(const Board &start, int turnLimit) : start(start), board(start), turnLimit(turnLimit) {}
+
+    void reset() {
+        board = start;
+        ply = 0;
+        hadRoyal[Board::WHITE] = !board.royalsOf(true).empty();
+        hadRoyal[Board::BLACK] = !board.royalsOf(false).empty();
+    }
+
+    int plies() const { return ply; }
+    const Board &position() const { return board; }
+
+    // Hamleyi kurallara göre uygula; yasal değilse tahta değişmez
+    Verdict play(std::string_view text) {
+        int x1, y1, x2, y2;
+        bool viaPortal;
+        if (!Notation::parseMove(text, board.board_size, x1, y1, x2, y2, &viaPortal)) return Verdict::BAD_NOTATION;
+        return play(board.squareIndex(x1, y1), board.squareIndex(x2, y2), viaPortal);
+    }
+
+    Verdict play(int from, int to, bool viaPortal) {
+        if (isOver()) return Verdict::GAME_OVER;
+
+        Rules::MoveError reason;
+        Move move = Rules::findLegalMove(board, from, to, viaPortal, &reason);
+        switch (reason) {
+        case Rules::MoveError::NONE: break;
+        case Rules::MoveError::NO_PIECE: return Verdict::NO_PIECE;
+        case Rules::MoveError::WRONG_SIDE: return Verdict::WRONG_SIDE;
+        case Rules::MoveError::NOT_A_MOVE: return Verdict::NOT_A_MOVE;
+        case Rules::MoveError::LEAVES_ROYAL_IN_CHECK: return Verdict::LEAVES_ROYAL_IN_CHECK;
+        }
+
+        board.makeMove(move, undo);
+        ++ply;
+        return Verdict::OK;
+    }
+
+private:
+    const Board &start;
+    Board board;
+    Board::UndoRecord undo;
+    int turnLimit;
+    int ply = 0;
+    bool hadRoyal[2] = {false, false};
+
+    // Oyun tur sınırında ya da bir taraf royal taşını kaybettiğinde biter; mat/pat
+    // konumunda hiçbir hamle yasal olmadığı için ayrıca denetlenmez
+    bool isOver() const {
+        if (ply >= turnLimit) return true;
+        return (hadRoyal[Board::WHITE] && board.royalsOf(true).empty()) ||
+               (hadRoyal[Board::BLACK] && board.royalsOf(false).empty());
+    }
+};
+
+// Hamle gibi görünen ilk sözcüğe kadarki alanlar (oyun numarası, sonuç, ...) üst bilgidir
+bool looksLikeMove(std::string_view token) {
+    // Sütun harfleri (geniş tahtalarda birden çok) ve ardından sıra numarası
+    std::size_t letters = 0;
+    while (letters < token.size() && token[letters] >= 'a' && token[letters] <= 'z') ++letters;
+    return token.size() >= 4 && letters >= 1 && letters < token.size() && token[letters] >= '0' &&
+           token[letters] <= '9';
+}
+
+// İkili arşiv: varyant özeti yüklenen yapılandırmayla aynı olmalı
+void replayRecord(const std::string &path, std::uint64_t variantHash, Replayer &replayer, FileStats &stats) {
+    GameRecordReader reader;
+    if (!reader.open(path)) {
+        stats.opened = false;
+        return;
+    }
+    if (reader.variantHash() != variantHash) {
+        stats.reports.push_back(path + ": recorded for a different variant");
+        ++stats.illegalGames;
+        return;
+    }
+
+    GameRecord::GameView game;
+    while (reader.next(game)) {
+        ++stats.games;
+        replayer.reset();
+
+        RecordedMove move;
+        auto cursor = game.cursor();
+        bool failed = false;
+        while (cursor.next(move)) {
+            Verdict verdict = replayer.play(move.from, move.to, move.viaPortal);
+            if (verdict != Verdict::OK) {
+                const Board &board = replayer.position();
+                ++stats.illegalGames;
+                stats.reports.push_back(path + ": game " + std::to_string(game.index) + ": ply " +
+                                        std::to_string(replayer.plies() + 1) + ": illegal move " +
+                                        Notation::moveToString(board, Move(move.from, move.to,
+                                                                           move.viaPortal ? Move::PORTAL : 0)) +
+                                        " (" + verdictName(verdict) + ")");
+                failed = true;
+                break;
+            }
+            ++stats.moves;
+        }
+        if (!failed && static_cast<std::uint32_t>(replayer.plies()) != game.plies) {
+            ++stats.illegalGames;
+            stats.reports.push_back(path + ": game " + std::to_string(game.index) + ": corrupt move data");
+        }
+    }
+    if (!reader.error().empty()) {
+        ++stats.illegalGames;
+        stats.reports.push_back(path + ": " + reader.error());
+    }
+}
+
+// Her boş olmayan satır bir oyundur; '#' ile başlayan satırlar yorumdur
+void replayFile(const std::string &path, Replayer &replayer, FileStats &stats) {
+    std::ifstream in(path);
+    if (!in) {
+        stats.opened = false;
+        return;
+    }
+
+    std::string line;
+    std::uint64_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        std::string_view rest(line);
+        if (!rest.empty() && rest.back() == '\r') rest.remove_suffix(1);
+        if (rest.empty() || rest[0] == '#') continue;
+
+        ++stats.games;
+        replayer.reset();
+        bool inMoves = false;
+
+        while (!rest.empty()) {
+            std::size_t begin = rest.find_first_not_of(" \t");
+            if (begin == std::string_view::npos) break;
+            rest.remove_prefix(begin);
+            std::size_t end = std::min(rest.find_first_of(" \t"), rest.size());
+            std::string_view token = rest.substr(0, end);
+            rest.remove_prefix(end);
+
+            if (!inMoves && !looksLikeMove(token)) continue;
+            inMoves = true;
+
+            Verdict verdict = replayer.play(token);
+            if (verdict != Verdict::OK) {
+                ++stats.illegalGames;
+                stats.reports.push_back(path + ":" + std::to_string(lineNumber) + ": ply " +
+                                        std::to_string(replayer.plies() + 1) + ": illegal move " +
+                                        std::string(token) + " (" + verdictName(verdict) + ")");
+                break;
+            }
+            ++stats.moves;
+        }
+    }
+}
+
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " <config.json> <games.txt|games.cgr>... [--jobs N] [--quiet]\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string configPath = argv[1];
+    std::vector<std::string> paths;
+    int jobs = 1;
+    bool quiet = false;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc && parseNumber(argv[i + 1], jobs)) {
+            jobs = std::max(1, jobs);
+            ++i;
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg.rfind("--", 0) == 0) {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    ConfigReader configReader;
+    if (!configReader.loadFromFile(configPath)) {
+        std::cerr << "Failed to load configuration. Exiting.\n";
+        return 1;
+    }
+
+    const GameConfig &config = configReader.getConfig();
+    Board board(config.game_settings.board_size);
+    board.initialize(config);
+
+    std::uint64_t variantHash = ConfigReader::hashConfig(config);
+
+    std::vector<FileStats> stats(paths.size());
+    auto start = std::chrono::steady_clock::now();
+
+    // Dosyalar iş parçacıkları arasında paylaştırılır; her iş parçacığının kendi tahtası var
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        Replayer replayer(board, config.game_settings.turn_limit);
+        for (std::size_t i = next++; i < paths.size(); i = next++) {
+            if (GameRecordReader::isRecordFile(paths[i])) {
+                replayRecord(paths[i], variantHash, replayer, stats[i]);
+            } else {
+                replayFile(paths[i], replayer, stats[i]);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < jobs; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    FileStats total;
+    bool failed = false;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        if (!stats[i].opened) {
+            std::cerr << "Failed to open " << paths[i] << "\n";
+            failed = true;
+            continue;
+        }
+        total.games += stats[i].games;
+        total.moves += stats[i].moves;
+        total.illegalGames += stats[i].illegalGames;
+        if (!quiet) {
+            for (const auto &report : stats[i].reports) {
+                std::cout << report << "\n";
+            }
+        }
+    }
+
+    std::cout << "Files: " << paths.size() << ", games: " << total.games << ", moves: " << total.moves << "\n";
+    std::cout << "Illegal games: " << total.illegalGames << "\n";
+    std::cout << "Time: " << elapsed << " s\n";
+    std::cout << "Games/s: " << (elapsed > 0 ? total.games / elapsed : 0) << "\n";
+    std::cout << "Moves/s: " << static_cast<std::uint64_t>(elapsed > 0 ? total.moves / elapsed : 0) << "\n";
+    return failed || total.illegalGames > 0 ? 1 : 0;
+}
@@ -0,0 +1,333 @@
+#include "Board.hpp"
+#include "CommandLine.hpp"
+#include "ComputerPlayer.hpp"
+#include "ConfigReader.hpp"
+#include "GameRecord.hpp"
+#include "Move.hpp"
+#include "Notation.hpp"
+#include "Rules.hpp"
+#include "Tablebase.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class Mover { RANDOM, ENGINE };
+
+enum class Reason { CHECKMATE, STALEMATE, ROYAL_CAPTURED, TURN_LIMIT, TABLEBASE };
+
+struct PlayedGame {
+    int winner = -1;   // Board::WHITE, Board::BLACK ya da -1 (berabere)
+    Reason reason = Reason::TURN_LIMIT;
+    std::vector<Move> moves;
+    std::uint64_t nodes = 0;
+};
+
+struct SelfPlayOptions {
+    int games = 100;
+    int jobs = 1;
+    std::uint64_t seed = 1;
+    int openingPlies = 4;
+    Mover movers[2] = {Mover::RANDOM, Mover::RANDOM};
+    SearchLimits limits;
+    std::size_t hashMb = 4;
+    std::string outPath = "selfplay_results.txt";
+    std::string recordPath;   // boş değilse oyunlar ikili arşive de yazılır
+    std::shared_ptr<const OpeningBook> book;
+    std::shared_ptr<const Tablebase> tablebase;   // varsa sonucu tabloda olan oyunlar orada biter
+};
+
+// Oyun numarasından bağımsız tohum: sonuç, oyunun hangi iş parçacığında oynandığına bağlı değil
+std::uint64_t gameSeed(std::uint64_t seed, int index) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * static_cast<std::uint64_t>(index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+const char *reasonName(Reason reason) {
+    switch (reason) {
+    case Reason::CHECKMATE: return "checkmate";
+    case Reason::STALEMATE: return "stalemate";
+    case Reason::ROYAL_CAPTURED: return "royal-captured";
+    case Reason::TURN_LIMIT: return "turn-limit";
+    case Reason::TABLEBASE: return "tablebase";
+    }
+    return "";
+}
+
+const char *resultName(int winner) {
+    return winner == Board::WHITE ? "1-0" : winner == Board::BLACK ? "0-1" : "1/2-1/2";
+}
+
+// Tek bir oyun: ekran çıktısı yok, hamle listesi ve sonuç döner.
+// İlk openingPlies hamle her iki taraf için de rastgele seçilir; motor-motor oyunları böylece ayrışır.
+PlayedGame playGame(const Board &start, int turnLimit, const SelfPlayOptions &options, std::uint64_t seed,
+                    std::unique_ptr<ComputerPlayer> *engines, std::vector<std::uint64_t> &keys) {
+    PlayedGame result;
+    result.moves.reserve(static_cast<std::size_t>(std::max(turnLimit, 0)));
+
+    Board board = start;
+    std::mt19937_64 rng(seed);
+    keys.clear();
+    for (int color = 0; color < 2; ++color) {
+        if (engines[color]) engines[color]->newGame();
+    }
+
+    bool hadRoyal[2] = {!board.royalsOf(true).empty(), !board.royalsOf(false).empty()};
+    MoveList moves;
+    Board::UndoRecord undo;
+
+    for (int ply = 0;; ++ply) {
+        bool white = board.whiteToMove;
+        int color = white ? Board::WHITE : Board::BLACK;
+        int enemy = white ? Board::BLACK : Board::WHITE;
+
+        if (hadRoyal[color] && board.royalsOf(white).empty()) {
+            result.winner = enemy;
+            result.reason = Reason::ROYAL_CAPTURED;
+            break;
+        }
+        Tablebase::Result known;
+        if (options.tablebase && options.tablebase->probe(board, known)) {
+            result.winner = known.wdl == Tablebase::Wdl::WIN ? color : known.wdl == Tablebase::Wdl::LOSS ? enemy : -1;
+            result.reason = Reason::TABLEBASE;
+            break;
+        }
+        if (ply >= turnLimit) {
+            result.reason = Reason::TURN_LIMIT;
+            break;
+        }
+
+        moves.clear();
+        Rules::generateLegalMoves(board, white, moves);
+        if (moves.empty()) {
+            bool mated = Rules::isCheck(board, white);
+            result.winner = mated ? enemy : -1;
+            result.reason = mated ? Reason::CHECKMATE : Reason::STALEMATE;
+            break;
+        }
+
+        Move move;
+        if (options.movers[color] == Mover::ENGINE && ply >= options.openingPlies) {
+            move = engines[color]->chooseMove(board, keys);
+            result.nodes += engines[color]->lastResult().nodes;
+        }
+        if (move.isNone()) {
+            move = moves[static_cast<std::size_t>(rng() % moves.size())];
+        }
+
+        keys.push_back(board.key());
+        board.makeMove(move, undo);
+        result.moves.push_back(move);
+    }
+    return result;
+}
+
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " <config.json> [--games N] [--jobs N] [--seed N] [--opening-plies N]\n"
+              << "       [--white random|engine] [--black random|engine] [--out FILE] [--record FILE] [--book FILE]\n"
+              << "       [--tablebase DIR] [--depth N] [--nodes N] [--movetime MS] [--threads N] [--hash MB]\n";
+}
+
+bool parseMover(const std::string &name, Mover &mover) {
+    if (name == "random") {
+        mover = Mover::RANDOM;
+    } else if (name == "engine") {
+        mover = Mover::ENGINE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string configPath = argv[1];
+    SelfPlayOptions options;
+    std::string bookPath;
+    std::string tablebasePath;
+    options.limits.maxDepth = 0;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--games" && i + 1 < argc && parseNumber(argv[i + 1], options.games)) {
+            options.games = std::max(0, options.games);
+            ++i;
+        } else if (arg == "--jobs" && i + 1 < argc && parseNumber(argv[i + 1], options.jobs)) {
+            options.jobs = std::max(1, options.jobs);
+            ++i;
+        } else if (arg == "--seed" && i + 1 < argc && parseNumber(argv[i + 1], options.seed)) {
+            ++i;
+        } else if (arg == "--opening-plies" && i + 1 < argc && parseNumber(argv[i + 1], options.openingPlies)) {
+            options.openingPlies = std::max(0, options.openingPlies);
+            ++i;
+        } else if ((arg == "--white" || arg == "--black") && i + 1 < argc) {
+            if (!parseMover(argv[++i], options.movers[arg == "--white" ? Board::WHITE : Board::BLACK])) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--out" && i + 1 < argc) {
+            options.outPath = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--book" && i + 1 < argc) {
+            bookPath = argv[++i];
+        } else if (arg == "--tablebase" && i + 1 < argc) {
+            tablebasePath = argv[++i];
+        } else if (ComputerPlayer::parseOption(argc, argv, i, options.limits, options.hashMb)) {
+            continue;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Sınır verilmezse motor sabit derinlikte arar; süre sınırı tekrarlanabilirliği bozar
+    if (options.limits.maxDepth == 0) {
+        options.limits.maxDepth = options.limits.maxNodes == 0 && options.limits.moveTimeMs == 0 ? 2 : 64;
+    }
+
+    ConfigReader configReader;
+    if (!configReader.loadFromFile(configPath)) {
+        std::cerr << "Failed to load configuration. Exiting.\n";
+        return 1;
+    }
+
+    const GameConfig &config = configReader.getConfig();
+    Board board(config.game_settings.board_size);
+    board.initialize(config);
+    int turnLimit = config.game_settings.turn_limit;
+
+    if (!bookPath.empty()) {
+        auto book = std::make_shared<OpeningBook>();
+        if (!book->open(bookPath)) {
+            std::cerr << book->error() << "\n";
+            return 1;
+        }
+        if (book->variantHash() != ConfigReader::hashConfig(config)) {
+            std::cerr << bookPath << " was built for a different variant\n";
+            return 1;
+        }
+        options.book = book;
+    }
+    if (!tablebasePath.empty()) {
+        auto tablebase = std::make_shared<Tablebase>();
+        if (!tablebase->open(tablebasePath, board, ConfigReader::hashConfig(config))) {
+            std::cerr << tablebase->error() << "\n";
+            return 1;
+        }
+        options.tablebase = tablebase;
+    }
+
+    std::cout << "Variant: " << config.game_settings.name << " (" << config.game_settings.board_size << "x"
+              << config.game_settings.board_size << ")\n";
+    std::cout << "Games: " << options.games << ", jobs: " << options.jobs << ", seed: " << options.seed << "\n";
+
+    std::vector<PlayedGame> results(static_cast<std::size_t>(options.games));
+    auto start = std::chrono::steady_clock::now();
+
+    // Oyunlar iş parçacıkları arasında paylaştırılır; her iş parçacığının kendi motorları var
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        std::unique_ptr<ComputerPlayer> engines[2];
+        for (int color = 0; color < 2; ++color) {
+            if (options.movers[color] == Mover::ENGINE) {
+                engines[color] = std::make_unique<ComputerPlayer>(options.limits, options.hashMb);
+                engines[color]->setBook(options.book);
+                engines[color]->setTablebase(options.tablebase);
+            }
+        }
+        std::vector<std::uint64_t> keys;
+        keys.reserve(static_cast<std::size_t>(std::max(turnLimit, 0)));
+
+        for (int i = next++; i < options.games; i = next++) {
+            results[i] = playGame(board, turnLimit, options, gameSeed(options.seed, i), engines, keys);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < options.jobs; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::uint64_t totalMoves = 0;
+    std::uint64_t totalNodes = 0;
+    int outcomes[3] = {0, 0, 0};   // beyaz, siyah, berabere
+    int reasons[5] = {0, 0, 0, 0, 0};
+    for (const auto &result : results) {
+        totalMoves += result.moves.size();
+        totalNodes += result.nodes;
+        ++outcomes[result.winner < 0 ? 2 : result.winner];
+        ++reasons[static_cast<int>(result.reason)];
+    }
+
+    // Her satır: oyun numarası, sonuç, bitiş nedeni, yarım hamle sayısı ve e2e4 biçiminde hamleler
+    std::ofstream out(options.outPath);
+    if (!out) {
+        std::cerr << "Failed to open " << options.outPath << " for writing.\n";
+        return 1;
+    }
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto &result = results[i];
+        out << i << " " << resultName(result.winner) << " " << reasonName(result.reason) << " "
+            << result.moves.size();
+        for (Move move : result.moves) {
+            out << " " << Notation::moveToString(board, move);
+        }
+        out << "\n";
+    }
+
+    if (!options.recordPath.empty()) {
+        GameRecordWriter record(options.recordPath, ConfigReader::hashConfig(config), board.board_size);
+        for (const auto &result : results) {
+            for (Move move : result.moves) {
+                record.addMove(move);
+            }
+            record.endGame(result.winner == Board::WHITE   ? GameResult::WHITE_WINS
+                           : result.winner == Board::BLACK ? GameResult::BLACK_WINS
+                                                           : GameResult::DRAW);
+        }
+        if (!record.close()) {
+            std::cerr << "Failed to write " << options.recordPath << ".\n";
+            return 1;
+        }
+    }
+
+    double games = std::max(options.games, 1);
+    std::cout << "\nWhite wins: " << outcomes[Board::WHITE] << ", black wins: " << outcomes[Board::BLACK]
+              << ", draws: " << outcomes[2] << "\n";
+    for (int r = 0; r < 5; ++r) {
+        std::cout << "  " << reasonName(static_cast<Reason>(r)) << ": " << reasons[r] << "\n";
+    }
+    std::cout << "Average length: " << totalMoves / games << " plies\n";
+    std::cout << "Time: " << elapsed << " s\n";
+    std::cout << "Games/s: " << (elapsed > 0 ? options.games / elapsed : 0) << "\n";
+    std::cout << "Moves/s: " << static_cast<std::uint64_t>(elapsed > 0 ? totalMoves / elapsed : 0) << "\n";
+    if (totalNodes > 0) {
+        std::cout << "Search nodes: " << totalNodes << "\n";
+    }
+    std::cout << "Results written to " << options.outPath << "\n";
+    if (!options.recordPath.empty()) {
+        std::cout << "Game record written to " << options.recordPath << "\n";
+    }
+    return 0;
+}
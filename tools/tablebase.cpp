@@ -0,0 +1,182 @@
+#include "Board.hpp"
+#include "CommandLine.hpp"
+#include "ConfigReader.hpp"
+#include "Move.hpp"
+#include "Notation.hpp"
+#include "Rules.hpp"
+#include "Tablebase.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+void printUsage(const char *program) {
+    std::cerr << "Usage: " << program << " build <config.json> <dir> <white types>/<black types> [--jobs N]\n"
+              << "       [--no-dtm] [--memory MB]\n"
+              << "       " << program << " probe <config.json> <dir> <white pieces> <black pieces> [white|black]\n"
+              << "Types are comma separated (King,Rook); pieces add a square (King:e1,Rook:a1).\n";
+}
+
+std::vector<std::string> splitList(const std::string &text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+bool addType(const Board &board, const std::string &name, int color, std::vector<Board::PieceCode> &material) {
+    int type = board.registry->find(name);
+    if (type < 0) {
+        std::cerr << "Unknown piece type: " << name << "\n";
+        return false;
+    }
+    material.push_back(Board::makeCode(type, color));
+    return true;
+}
+
+int build(const GameConfig &config, const Board &board, int argc, char *argv[]) {
+    if (argc < 5) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::string directory = argv[3];
+    std::string spec = argv[4];
+    Tablebase::BuildOptions options;
+
+    for (int i = 5; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc && parseNumber(argv[i + 1], options.jobs)) {
+            options.jobs = std::max(1, options.jobs);
+            ++i;
+        } else if (arg == "--memory" && i + 1 < argc && parseNumber(argv[i + 1], options.memoryMb)) {
+            ++i;
+        } else if (arg == "--no-dtm") {
+            options.dtm = false;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::size_t slash = spec.find('/');
+    if (slash == std::string::npos) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::vector<Board::PieceCode> material;
+    for (const auto &name : splitList(spec.substr(0, slash))) {
+        if (!addType(board, name, Board::WHITE, material)) return 1;
+    }
+    for (const auto &name : splitList(spec.substr(slash + 1))) {
+        if (!addType(board, name, Board::BLACK, material)) return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Tablebase::BuildStats stats;
+    std::string error;
+    if (!Tablebase::build(board, ConfigReader::hashConfig(config), material, directory, options, stats, error)) {
+        std::cerr << "Tablebase build failed: " << error << "\n";
+        return 1;
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Tables solved: " << stats.tables << " (reused " << stats.reused << ")\n";
+    std::sort(material.begin(), material.end());
+    std::cout << Tablebase::fileName(board, material) << ": " << stats.positions << " positions, "
+              << stats.symmetries << " symmetries\n";
+    std::cout << "  wins " << stats.wins << ", draws " << stats.draws << ", losses " << stats.losses
+              << ", longest mate " << stats.maxDtm << " plies\n";
+    std::cout << "Time: " << elapsed << " s\n";
+    return 0;
+}
+
+bool placePieces(Board &board, const std::string &list, int color) {
+    for (const auto &item : splitList(list)) {
+        std::size_t colon = item.find(':');
+        int type = colon == std::string::npos ? -1 : board.registry->find(item.substr(0, colon));
+        int x, y;
+        if (type < 0 || !Notation::parseSquare(item.substr(colon + 1), board.board_size, x, y) ||
+            board.hasPieceAt(x, y)) {
+            std::cerr << "Invalid piece: " << item << "\n";
+            return false;
+        }
+        board.setPiece(board.squareIndex(x, y), Board::makeCode(type, color) | Board::MOVED_BIT);
+    }
+    return true;
+}
+
+std::string describe(const Tablebase::Result &result) {
+    std::string text = result.wdl == Tablebase::Wdl::WIN ? "win" : result.wdl == Tablebase::Wdl::LOSS ? "loss" : "draw";
+    if (result.wdl != Tablebase::Wdl::DRAW && result.dtm >= 0) text += " in " + std::to_string(result.dtm) + " plies";
+    return text;
+}
+
+int probe(const GameConfig &config, Board &board, int argc, char *argv[]) {
+    if (argc < 6) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Tablebase tablebase;
+    if (!tablebase.open(argv[3], board, ConfigReader::hashConfig(config))) {
+        std::cerr << tablebase.error() << "\n";
+        return 1;
+    }
+
+    for (int color = 0; color < 2; ++color) {
+        while (!board.pieceSquares[color].empty()) board.setPiece(board.pieceSquares[color].back(), Board::EMPTY);
+    }
+    if (!placePieces(board, argv[4], Board::WHITE) || !placePieces(board, argv[5], Board::BLACK)) return 1;
+    board.setSideToMove(argc < 7 || std::string(argv[6]) != "black");
+
+    Tablebase::Result result;
+    if (!tablebase.probe(board, result)) {
+        std::cout << "Position is not in the tablebase\n";
+        return 1;
+    }
+    std::cout << (board.whiteToMove ? "White" : "Black") << " to move: " << describe(result) << "\n";
+
+    // Tablonun önerdiği en iyi yol
+    std::cout << "Line:";
+    Board::UndoRecord undo;
+    for (int ply = 0; ply < 256; ++ply) {
+        Move move = tablebase.bestMove(board, &result);
+        if (move.isNone() || (result.wdl == Tablebase::Wdl::DRAW && ply >= 8)) break;
+        std::cout << " " << Notation::moveToString(board, move);
+        board.makeMove(move, undo);
+    }
+    std::cout << "\n";
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string mode = argv[1];
+    if (mode != "build" && mode != "probe") {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    ConfigReader configReader;
+    if (!configReader.loadFromFile(argv[2])) {
+        std::cerr << "Failed to load configuration. Exiting.\n";
+        return 1;
+    }
+
+    const GameConfig &config = configReader.getConfig();
+    Board board(config.game_settings.board_size);
+    board.initialize(config);
+
+    return mode == "build" ? build(config, board, argc, argv) : probe(config, board, argc, argv);
+}